@@ -9,6 +9,8 @@
 #include "custom-names.h"
 #include "port-enable.h"
 #include "stereo-link.h"
+#include "snapshot-history.h"
+#include "mixer-feedback.h"
 
 // check that *config is a compound node, retrieve the first node
 // within, check that that node is a compound node, optionally check
@@ -535,6 +537,8 @@ void create_sim_from_file(GtkWindow *w, char *fn) {
   custom_names_init(card);
   port_enable_init(card);
   stereo_link_init(card);
+  snapshot_history_init(card);
+  mixer_feedback_init(card);
 
   create_card_window(card);
 }
@@ -12,12 +12,16 @@
 #include "stringhelper.h"
 #include "window-iface.h"
 #include "optional-controls.h"
+#include "optional-state.h"
 #include "custom-names.h"
 #include "port-enable.h"
 #include "stereo-link.h"
 #include "dsp-state.h"
 #include "hw-io-availability.h"
 #include "presets.h"
+#include "routing-graph.h"
+#include "snapshot-history.h"
+#include "mixer-feedback.h"
 
 #define MAJOR_HWDEP_VERSION_SCARLETT2 1
 #define MAJOR_HWDEP_VERSION_FCP 2
@@ -416,34 +420,85 @@ static void alsa_get_elem_int_range(struct alsa_elem *elem) {
   elem->max_val = snd_ctl_elem_info_get_max(elem_info);
 }
 
-// get the number of items this enum element has
-int alsa_get_item_count(struct alsa_elem *elem) {
-  if (elem->card->num == SIMULATED_CARD_NUM || elem->is_simulated)
-    return elem->item_count;
-
+// read the writable and volatile flags of a real element into the
+// element (as simulated elements have them)
+static void alsa_update_elem_access(struct alsa_elem *elem) {
   snd_ctl_elem_info_t *elem_info;
 
   snd_ctl_elem_info_alloca(&elem_info);
   snd_ctl_elem_info_set_numid(elem_info, elem->numid);
   snd_ctl_elem_info(elem->card->handle, elem_info);
 
-  return snd_ctl_elem_info_get_items(elem_info);
+  elem->is_writable = snd_ctl_elem_info_is_writable(elem_info) &&
+                      !snd_ctl_elem_info_is_locked(elem_info);
+  elem->is_volatile = snd_ctl_elem_info_is_volatile(elem_info);
 }
 
-// get the name of an item of the given enum element
-char *alsa_get_item_name(struct alsa_elem *elem, int i) {
-  if (elem->card->num == SIMULATED_CARD_NUM || elem->is_simulated)
-    return strdup(elem->item_names[i]);
+// read the item names of a real enum element into the element (as
+// simulated elements have them), so each is only read once
+static void alsa_load_item_names(struct alsa_elem *elem) {
+  if (elem->item_names)
+    return;
 
   snd_ctl_elem_info_t *elem_info;
 
   snd_ctl_elem_info_alloca(&elem_info);
   snd_ctl_elem_info_set_numid(elem_info, elem->numid);
-  snd_ctl_elem_info_set_item(elem_info, i);
   snd_ctl_elem_info(elem->card->handle, elem_info);
 
-  const char *name = snd_ctl_elem_info_get_item_name(elem_info);
-  return strdup(name);
+  int count = snd_ctl_elem_info_get_items(elem_info);
+
+  elem->item_count = count;
+  elem->item_names = calloc(count + 1, sizeof(char *));
+
+  for (int i = 0; i < count; i++) {
+    snd_ctl_elem_info_set_item(elem_info, i);
+    snd_ctl_elem_info(elem->card->handle, elem_info);
+    elem->item_names[i] = strdup(snd_ctl_elem_info_get_item_name(elem_info));
+  }
+}
+
+static void alsa_free_item_names(struct alsa_elem *elem) {
+  if (!elem->item_names)
+    return;
+
+  for (int i = 0; i < elem->item_count; i++)
+    free(elem->item_names[i]);
+  free(elem->item_names);
+
+  elem->item_names = NULL;
+  elem->item_count = 0;
+}
+
+// get the number of items this enum element has
+int alsa_get_item_count(struct alsa_elem *elem) {
+  if (!(elem->card->num == SIMULATED_CARD_NUM || elem->is_simulated))
+    alsa_load_item_names(elem);
+
+  return elem->item_count;
+}
+
+// get the name of an item of the given enum element
+char *alsa_get_item_name(struct alsa_elem *elem, int i) {
+  if (!(elem->card->num == SIMULATED_CARD_NUM || elem->is_simulated))
+    alsa_load_item_names(elem);
+
+  if (i < 0 || i >= elem->item_count)
+    return strdup("");
+
+  return strdup(elem->item_names[i]);
+}
+
+// get the name of an item of the given enum element without copying
+// it; valid until the element's info changes
+const char *alsa_peek_item_name(struct alsa_elem *elem, int i) {
+  if (!(elem->card->num == SIMULATED_CARD_NUM || elem->is_simulated))
+    alsa_load_item_names(elem);
+
+  if (i < 0 || i >= elem->item_count)
+    return NULL;
+
+  return elem->item_names[i];
 }
 
 // get the bytes data from a BYTES element
@@ -711,6 +766,7 @@ static void alsa_get_elem(struct alsa_card *card, int numid) {
   alsa_elem.type = alsa_get_elem_type(&alsa_elem);
   alsa_elem.name = alsa_get_elem_name(&alsa_elem);
   alsa_elem.count = alsa_get_elem_count(&alsa_elem);
+  alsa_update_elem_access(&alsa_elem);
 
   switch (alsa_elem.type) {
     case SND_CTL_ELEM_TYPE_BOOLEAN:
@@ -1112,6 +1168,7 @@ void alsa_get_routing_controls(struct alsa_card *card) {
 
   get_routing_srcs(card);
   get_routing_snks(card);
+  routing_graph_rebuild(card);
   get_monitor_group_src_map(card);
 
   // look up Digital I/O Mode element for HW I/O availability
@@ -1139,6 +1196,16 @@ void alsa_elem_change(struct alsa_elem *elem) {
   if (!elem || !elem->callbacks)
     return;
 
+  GPtrArray *batch = elem->card ? elem->card->elem_change_batch : NULL;
+
+  if (batch) {
+    if (!elem->in_change_batch) {
+      elem->in_change_batch = 1;
+      g_ptr_array_add(batch, elem);
+    }
+    return;
+  }
+
   for (GList *l = elem->callbacks; l; l = l->next) {
     struct alsa_elem_callback *cb = (struct alsa_elem_callback *)l->data;
 
@@ -1149,6 +1216,29 @@ void alsa_elem_change(struct alsa_elem *elem) {
   }
 }
 
+void alsa_elem_change_batch_begin(struct alsa_card *card) {
+  if (!card->elem_change_batch)
+    card->elem_change_batch = g_ptr_array_new();
+}
+
+void alsa_elem_change_batch_end(struct alsa_card *card) {
+  GPtrArray *batch = card->elem_change_batch;
+
+  if (!batch)
+    return;
+
+  card->elem_change_batch = NULL;
+
+  for (int i = 0; i < batch->len; i++) {
+    struct alsa_elem *elem = g_ptr_array_index(batch, i);
+
+    elem->in_change_batch = 0;
+    alsa_elem_change(elem);
+  }
+
+  g_ptr_array_free(batch, TRUE);
+}
+
 static void card_destroy_callback(void *data) {
   struct alsa_card *card = data;
 
@@ -1161,6 +1251,10 @@ static void card_destroy_callback(void *data) {
   // close the windows associated with this card
   destroy_card_window(card);
 
+  snapshot_history_free(card);
+  mixer_feedback_free(card);
+  optional_state_forget(card);
+
   // free all elements and their callbacks
   if (card->elems) {
     for (int i = 0; i < card->elems->len; i++) {
@@ -1194,11 +1288,7 @@ static void card_destroy_callback(void *data) {
           free(elem->meter_labels[j]);
         free(elem->meter_labels);
       }
-      if (elem->item_names) {
-        for (int j = 0; j < elem->item_count; j++)
-          free(elem->item_names[j]);
-        free(elem->item_names);
-      }
+      alsa_free_item_names(elem);
 
       // free the element struct itself
       free(elem);
@@ -1296,6 +1386,8 @@ static void complete_card_init(struct alsa_card *card) {
   port_enable_init(card);
   stereo_link_init(card);
   dsp_state_init(card);
+  snapshot_history_init(card);
+  mixer_feedback_init(card);
   card->best_firmware_version = scarlett2_get_best_firmware_version(card->pid);
 
   // For FCP/scarlett4 devices, get the 4-valued best firmware version
@@ -1456,6 +1548,12 @@ static gboolean alsa_card_callback(
         elem->values = new_values;
       }
 
+      // refresh the cached info
+      if ((mask & SND_CTL_EVENT_MASK_INFO) && !elem->is_simulated) {
+        alsa_update_elem_access(elem);
+        alsa_free_item_names(elem);
+      }
+
       // Info events (writable/range changes) always need a
       // callback; value-only events only when the value changed.
       if (value_changed || (mask & SND_CTL_EVENT_MASK_INFO))
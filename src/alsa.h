@@ -14,6 +14,10 @@
 // forward definitions
 struct alsa_elem;
 struct alsa_card;
+struct routing_lines_cache;
+struct routing_hit_index;
+struct snapshot_history;
+struct mixer_feedback;
 
 // typedef for callbacks to update widgets when the alsa element
 // notifies of a change
@@ -137,6 +141,12 @@ struct routing_src {
 
   // cached level meter index (-1 if none)
   int level_index;
+
+  // first sink whose effective source is this source (index into
+  // routing_snks, -1 if none), and the number of such sinks
+  // maintained by routing-graph.c
+  int first_snk_idx;
+  int snk_count;
 };
 
 // entry in alsa_card routing_snks (routing sinks) array for alsa
@@ -202,6 +212,11 @@ struct routing_snk {
 
   // cached level meter index (-1 if none)
   int level_index;
+
+  // previous/next sinks with the same effective source (indices into
+  // routing_snks, -1 if none); maintained by routing-graph.c
+  int prev_snk_idx;
+  int next_snk_idx;
 };
 
 // hold one callback & its data
@@ -245,13 +260,16 @@ struct alsa_elem {
   GList *callbacks;
 
   // for simulated elements, the current state
+  // for real elements, the flags and values are cached, kept up to
+  // date from the ALSA events
   int  is_simulated;
   int  is_writable;
   int  is_volatile;
   long  value;
   long *values;  // cached multi-value integer state
 
-  // for simulated enumerated elements, the items
+  // for enumerated elements, the items (read on first use for real
+  // elements)
   int    item_count;
   char **item_names;
 
@@ -261,6 +279,9 @@ struct alsa_elem {
 
   // pending idle callback for change notification
   guint pending_idle;
+
+  // queued in the card's change batch
+  int in_change_batch;
 };
 
 struct alsa_card {
@@ -312,10 +333,15 @@ struct alsa_card {
   GtkWidget          *mixer_unavailable_label;
   GtkWidget          *mixer_corner_label;
   GList              *mixer_gain_widgets;
+  int                 mixer_cell_w;
+  int                 mixer_cell_h;
+  guint               mixer_cells_idle;
   GList              *input_gain_widgets;
   GList              *output_gain_widgets;
   GList              *dsp_comp_widgets;
   GtkWidget          *routing_lines;
+  struct routing_lines_cache *routing_lines_cache;
+  struct routing_hit_index *routing_hit_index;
   GtkWidget          *routing_hw_in_grid;
   GtkWidget          *routing_hw_out_grid;
   GtkWidget          *routing_pcm_in_grid;
@@ -343,6 +369,8 @@ struct alsa_card {
   struct routing_snk *hovered_snk;
   int                 pending_ui_updates;
   gboolean            pending_ui_update_idle;
+  gboolean            routing_ui_update_deferred;
+  GPtrArray          *elem_change_batch;
   guint               levels_timer;
 
   // PCM channel availability based on sample rate
@@ -364,6 +392,12 @@ struct alsa_card {
 
   struct alsa_elem   *mixer_gains[MAX_MIX_OUT][MAX_MUX_IN];
 
+  // undo/redo and A/B history of the routing and mixer gains
+  struct snapshot_history *snapshot_history;
+
+  // feedback loop detection through the internal mixer
+  struct mixer_feedback *mixer_feedback;
+
   // level meter support (set at init, not persisted)
   int                 has_levels;
 
@@ -378,6 +412,7 @@ struct alsa_card {
 // flags for pending_ui_updates
 #define PENDING_UI_UPDATE_MIXER_GRID     (1 << 0)
 #define PENDING_UI_UPDATE_MONITOR_GROUPS (1 << 1)
+#define PENDING_UI_UPDATE_ROUTING        (1 << 2)
 
 // utility
 void fatal_alsa_error(const char *msg, int err);
@@ -406,6 +441,11 @@ void alsa_elem_remove_callbacks_by_data(struct alsa_elem *elem, void *data);
 // trigger callbacks for an element (notify of value change)
 void alsa_elem_change(struct alsa_elem *elem);
 
+// between these, alsa_elem_change() only records the element; the
+// callbacks of each changed element are run once at the end
+void alsa_elem_change_batch_begin(struct alsa_card *card);
+void alsa_elem_change_batch_end(struct alsa_card *card);
+
 // alsa snd_ctl_elem_*() functions
 int alsa_get_elem_type(struct alsa_elem *elem);
 char *alsa_get_elem_name(struct alsa_elem *elem);
@@ -418,6 +458,7 @@ int alsa_get_elem_volatile(struct alsa_elem *elem);
 int alsa_get_elem_count(struct alsa_elem *elem);
 int alsa_get_item_count(struct alsa_elem *elem);
 char *alsa_get_item_name(struct alsa_elem *elem, int i);
+const char *alsa_peek_item_name(struct alsa_elem *elem, int i);
 
 // BYTES element support
 const void *alsa_get_elem_bytes(struct alsa_elem *elem, size_t *size);
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
 #include "biquad.h"
 
 // Filter type names
@@ -291,6 +293,110 @@ double biquad_response_db(
   return 10.0 * log10(mag_sq);
 }
 
+void biquad_freq_table_init(
+  struct biquad_freq_table *table,
+  const double *freqs,
+  int count,
+  double sample_rate
+) {
+  table->count = count;
+  table->cos_w = g_new(double, count);
+  table->cos_2w = g_new(double, count);
+  table->sin_w = g_new(double, count);
+  table->sin_2w = g_new(double, count);
+
+  for (int i = 0; i < count; i++) {
+    double w = 2.0 * M_PI * freqs[i] / sample_rate;
+    table->cos_w[i] = cos(w);
+    table->cos_2w[i] = cos(2.0 * w);
+    table->sin_w[i] = sin(w);
+    table->sin_2w[i] = sin(2.0 * w);
+  }
+}
+
+void biquad_freq_table_free(struct biquad_freq_table *table) {
+  g_free(table->cos_w);
+  g_free(table->cos_2w);
+  g_free(table->sin_w);
+  g_free(table->sin_2w);
+  table->cos_w = table->cos_2w = table->sin_w = table->sin_2w = NULL;
+  table->count = 0;
+}
+
+// Approximate log10 for positive normal x, written without branches
+// so that the calling loop vectorises.
+// x = m × 2^e with m in [1, 2); log2(m) = 2/ln(2) × atanh(t) where
+// t = (m - 1) / (m + 1) is in [0, 1/3), summed to the t^7 term.
+static inline double fast_log10(double x) {
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+
+  double e = (double)(int)((bits >> 52) & 0x7ff) - 1023.0;
+  bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+
+  double m;
+  memcpy(&m, &bits, sizeof(m));
+
+  double t = (m - 1.0) / (m + 1.0);
+  double t2 = t * t;
+  double atanh_t =
+    t * (1.0 + t2 * (1.0 / 3 + t2 * (1.0 / 5 + t2 * (1.0 / 7))));
+
+  // log10(x) = (e + log2(m)) × log10(2)
+  return (e + atanh_t * (2.0 / M_LN2)) * M_LN2 / M_LN10;
+}
+
+void biquad_response_db_batch(
+  const struct biquad_coeffs *coeffs,
+  int n_coeffs,
+  const struct biquad_freq_table *table,
+  gboolean fast_log,
+  double *db
+) {
+  int count = table->count;
+  const double *restrict cos_w = table->cos_w;
+  const double *restrict cos_2w = table->cos_2w;
+  const double *restrict sin_w = table->sin_w;
+  const double *restrict sin_2w = table->sin_2w;
+
+  for (int c = 0; c < n_coeffs; c++) {
+    double b0 = coeffs[c].b0, b1 = coeffs[c].b1, b2 = coeffs[c].b2;
+    double a1 = coeffs[c].a1, a2 = coeffs[c].a2;
+    double *restrict out = db + c * count;
+
+    // |H|^2 for every frequency (same maths as biquad_response_db())
+    for (int i = 0; i < count; i++) {
+      double num_real = b0 + b1 * cos_w[i] + b2 * cos_2w[i];
+      double num_imag = -b1 * sin_w[i] - b2 * sin_2w[i];
+      double den_real = 1.0 + a1 * cos_w[i] + a2 * cos_2w[i];
+      double den_imag = -a1 * sin_w[i] - a2 * sin_2w[i];
+
+      double num_mag_sq = num_real * num_real + num_imag * num_imag;
+      double den_mag_sq = den_real * den_real + den_imag * den_imag;
+
+      // mark out-of-range values with 0 (→ 0 dB) and -1 (→ -100 dB)
+      // so that the loop stays branch-free
+      double mag_sq = num_mag_sq / (den_mag_sq < 1e-20 ? 1.0 : den_mag_sq);
+      out[i] = den_mag_sq < 1e-20 ? 0.0 : mag_sq < 1e-20 ? -1.0 : mag_sq;
+    }
+
+    // convert to dB
+    if (fast_log) {
+      for (int i = 0; i < count; i++) {
+        double v = out[i];
+        double ok = v > 0 ? v : 1.0;
+        double v_db = 10.0 * fast_log10(ok);
+        out[i] = v > 0 ? v_db : v < 0 ? -100.0 : 0.0;
+      }
+    } else {
+      for (int i = 0; i < count; i++) {
+        double v = out[i];
+        out[i] = v > 0 ? 10.0 * log10(v) : v < 0 ? -100.0 : 0.0;
+      }
+    }
+  }
+}
+
 void biquad_from_fixed_point(
   const long fixed[5],
   struct biquad_coeffs *coeffs
@@ -66,6 +66,39 @@ double biquad_response_db(
   double sample_rate
 );
 
+// Precomputed cos(w), cos(2w), sin(w), sin(2w) for a fixed set of
+// frequencies at a fixed sample rate, for biquad_response_db_batch()
+struct biquad_freq_table {
+  int     count;
+  double *cos_w;
+  double *cos_2w;
+  double *sin_w;
+  double *sin_2w;
+};
+
+// Fill in a frequency table; free with biquad_freq_table_free()
+void biquad_freq_table_init(
+  struct biquad_freq_table *table,
+  const double *freqs,
+  int count,
+  double sample_rate
+);
+
+void biquad_freq_table_free(struct biquad_freq_table *table);
+
+// Calculate frequency response magnitude in dB for n_coeffs
+// coefficient sets at every frequency in the table. Results for
+// coefficient set i are at db[i * table->count].
+// If fast_log is set, an approximate log10 is used (error well
+// under 0.001 dB), otherwise results match biquad_response_db().
+void biquad_response_db_batch(
+  const struct biquad_coeffs *coeffs,
+  int n_coeffs,
+  const struct biquad_freq_table *table,
+  gboolean fast_log,
+  double *db
+);
+
 // Get human-readable filter type name
 const char *biquad_type_name(BiquadFilterType type);
 
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <stdint.h>
+
+#include "blur.h"
+
+// the column blur replaces sum / count with a multiply and shift;
+// this is exact for sum <= 255 × count while 255 × count² < 2^20,
+// i.e. count <= 64
+#define RECIP_SHIFT 20
+#define MAX_RECIP_RADIUS 31
+
+// tile size for transposes so source and destination lines both
+// stay in cache
+#define TRANSPOSE_TILE 16
+
+// transpose a width × height plane into a height × width plane
+static void transpose_plane(
+  const unsigned char *src,
+  unsigned char       *dst,
+  int                  width,
+  int                  height
+) {
+  for (int ty = 0; ty < height; ty += TRANSPOSE_TILE) {
+    int y_end = MIN(ty + TRANSPOSE_TILE, height);
+
+    for (int tx = 0; tx < width; tx += TRANSPOSE_TILE) {
+      int x_end = MIN(tx + TRANSPOSE_TILE, width);
+
+      for (int y = ty; y < y_end; y++)
+        for (int x = tx; x < x_end; x++)
+          dst[x * height + y] = src[y * width + x];
+    }
+  }
+}
+
+// vertical box blur of src into dst. the window sums for every
+// column are kept in sum[] and updated a whole row at a time, so
+// the inner loops run over contiguous memory and vectorise.
+static void blur_columns(
+  const unsigned char *restrict src,
+  unsigned char       *restrict dst,
+  int                           width,
+  int                           height,
+  int                           radius,
+  uint32_t            *restrict sum
+) {
+  // build initial window for y=0: [0, min(radius, height-1)]
+  int bottom = MIN(radius, height - 1);
+
+  for (int x = 0; x < width; x++)
+    sum[x] = 0;
+  for (int y = 0; y <= bottom; y++) {
+    const unsigned char *row = src + y * width;
+    for (int x = 0; x < width; x++)
+      sum[x] += row[x];
+  }
+
+  for (int y = 0; y < height; y++) {
+    uint32_t count =
+      MIN(y, radius) + MIN(height - 1 - y, radius) + 1;
+    unsigned char *out = dst + y * width;
+
+    if (radius <= MAX_RECIP_RADIUS) {
+      uint32_t recip = ((1 << RECIP_SHIFT) + count - 1) / count;
+      for (int x = 0; x < width; x++)
+        out[x] = (sum[x] * recip) >> RECIP_SHIFT;
+    } else {
+      for (int x = 0; x < width; x++)
+        out[x] = sum[x] / count;
+    }
+
+    // slide window: remove departing top, add arriving bottom
+    int rem = y - radius;
+    int add = y + radius + 1;
+    if (rem >= 0) {
+      const unsigned char *row = src + rem * width;
+      for (int x = 0; x < width; x++)
+        sum[x] -= row[x];
+    }
+    if (add < height) {
+      const unsigned char *row = src + add * width;
+      for (int x = 0; x < width; x++)
+        sum[x] += row[x];
+    }
+  }
+}
+
+void box_blur_plane(
+  unsigned char *plane,
+  int            width,
+  int            height,
+  int            radius,
+  int            passes
+) {
+  if (width <= 0 || height <= 0)
+    return;
+
+  unsigned char *tmp = g_malloc(width * height);
+  uint32_t *sum = g_malloc(MAX(width, height) * sizeof(uint32_t));
+
+  for (int pass = 0; pass < passes; pass++) {
+
+    // horizontal: transpose so rows become columns, blur, and
+    // transpose back
+    transpose_plane(plane, tmp, width, height);
+    blur_columns(tmp, plane, height, width, radius, sum);
+    transpose_plane(plane, tmp, height, width);
+
+    // vertical
+    blur_columns(tmp, plane, width, height, radius, sum);
+  }
+
+  g_free(sum);
+  g_free(tmp);
+}
@@ -0,0 +1,17 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <glib.h>
+
+// Apply passes × (horizontal, vertical) box blur to a packed 8-bit
+// alpha plane in-place. Both directions run as a column-parallel
+// sliding window over contiguous rows.
+void box_blur_plane(
+  unsigned char *plane,
+  int            width,
+  int            height,
+  int            radius,
+  int            passes
+);
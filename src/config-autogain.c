@@ -10,21 +10,26 @@
 
 #define AUTOGAIN_TARGET_COUNT 3
 
-void add_autogain_tab(GtkWidget *notebook, struct alsa_card *card) {
-  static const char *names[] = {
-    "Autogain Hot Target",
-    "Autogain Mean Target",
-    "Autogain Peak Target"
-  };
-  static const char *labels[] = { "Hot", "Mean", "Peak" };
+static const char *names[] = {
+  "Autogain Hot Target",
+  "Autogain Mean Target",
+  "Autogain Peak Target"
+};
 
+static int get_autogain_target_count(struct alsa_card *card) {
   int count = 0;
+
   for (int i = 0; i < AUTOGAIN_TARGET_COUNT; i++)
     if (get_elem_by_name(card->elems, names[i]))
       count++;
 
-  if (!count)
-    return;
+  return count;
+}
+
+static void build_autogain_tab(GtkWidget *page, struct alsa_card *card) {
+  static const char *labels[] = { "Hot", "Mean", "Peak" };
+
+  int count = get_autogain_target_count(card);
 
   GtkWidget *content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
   gtk_widget_set_margin_start(content, 20);
@@ -68,8 +73,15 @@ void add_autogain_tab(GtkWidget *notebook, struct alsa_card *card) {
 
   gtk_box_append(GTK_BOX(content), grid);
 
-  g_object_set_data(G_OBJECT(content), PAGE_ID_KEY, (gpointer)"autogain");
-  gtk_notebook_append_page(
-    GTK_NOTEBOOK(notebook), content, gtk_label_new("Autogain")
+  gtk_box_append(GTK_BOX(page), content);
+}
+
+void add_autogain_tab(GtkWidget *notebook, struct alsa_card *card) {
+  if (!get_autogain_target_count(card))
+    return;
+
+  append_lazy_notebook_page(
+    GTK_NOTEBOOK(notebook), "autogain",
+    gtk_label_new("Autogain"), build_autogain_tab, card
   );
 }
@@ -10,10 +10,8 @@
 #include "window-configuration.h"
 #include "config-device-name.h"
 
-void add_device_name_tab(GtkWidget *notebook, struct alsa_card *card) {
+static void build_device_name_tab(GtkWidget *page, struct alsa_card *card) {
   struct alsa_elem *name_elem = optional_controls_get_name_elem(card);
-  if (!name_elem)
-    return;
 
   GtkWidget *content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
   gtk_widget_set_margin_top(content, 20);
@@ -27,8 +25,15 @@ void add_device_name_tab(GtkWidget *notebook, struct alsa_card *card) {
   gtk_widget_set_hexpand(entry, TRUE);
   gtk_box_append(GTK_BOX(content), entry);
 
-  g_object_set_data(G_OBJECT(content), PAGE_ID_KEY, (gpointer)"device-name");
-  gtk_notebook_append_page(
-    GTK_NOTEBOOK(notebook), content, gtk_label_new("Device Name")
+  gtk_box_append(GTK_BOX(page), content);
+}
+
+void add_device_name_tab(GtkWidget *notebook, struct alsa_card *card) {
+  if (!optional_controls_get_name_elem(card))
+    return;
+
+  append_lazy_notebook_page(
+    GTK_NOTEBOOK(notebook), "device-name",
+    gtk_label_new("Device Name"), build_device_name_tab, card
   );
 }
@@ -15,6 +15,9 @@
 // Key for I/O sub-tab persistence
 #define CONFIG_IO_TAB_KEY "configuration-io-tab"
 
+// Key for the tab_checkbox_data of an I/O sub-tab page
+#define IO_TAB_DATA_KEY "io-tab-data"
+
 // Structure to track a column's enable-all checkbox and its children
 struct column_checkbox_data {
   GtkWidget *column_checkbox;
@@ -24,13 +27,21 @@ struct column_checkbox_data {
 };
 
 // Structure to track a tab's enable-all checkbox and its column checkboxes
+// The tab checkbox follows the tab's enable elements, so it works
+// before the page has been built
 struct tab_checkbox_data {
-  GtkWidget                   *tab_checkbox;
-  struct column_checkbox_data *left_column;   // can be NULL if no inputs
-  struct column_checkbox_data *right_column;  // can be NULL if no outputs
-  GArray                      *columns;       // array of column_checkbox_data* for multi-column support
-  int                          updating;      // flag to prevent recursion
-  int                          was_inconsistent;  // track if we were inconsistent before click
+  GtkWidget  *tab_checkbox;
+  GArray     *elems;             // array of struct alsa_elem*, all the tab's enables
+  GArray     *columns;           // array of column_checkbox_data*, once built
+  int         updating;          // flag to prevent recursion
+  int         was_inconsistent;  // track if we were inconsistent before click
+
+  // what the tab shows, for building it when first shown
+  int         port_category;
+  int         hw_type;           // only used for PC_HW, -1 for others
+  const char *tab_name;
+  int         show_inputs;
+  int         show_outputs;
 };
 
 // Free column checkbox data
@@ -121,68 +132,35 @@ static void column_checkbox_toggled(GtkCheckButton *button, gpointer user_data)
 static void free_tab_checkbox_data(gpointer data) {
   struct tab_checkbox_data *tcd = data;
   // don't free column data - they're managed by the columns themselves
-  if (tcd->columns)
-    g_array_free(tcd->columns, TRUE);
+  g_array_free(tcd->elems, TRUE);
+  g_array_free(tcd->columns, TRUE);
   g_free(tcd);
 }
 
-// Helper to count column state
-static void count_column_state(
-  struct column_checkbox_data *col,
-  int *all_enabled,
-  int *all_disabled,
-  int *columns_exist
-) {
-  if (!col || !col->child_elems)
-    return;
-
-  (*columns_exist)++;
-  if (gtk_check_button_get_inconsistent(GTK_CHECK_BUTTON(col->column_checkbox))) {
-    // mixed state - don't count as enabled or disabled
-  } else if (gtk_check_button_get_active(GTK_CHECK_BUTTON(col->column_checkbox))) {
-    (*all_enabled)++;
-  } else {
-    (*all_disabled)++;
-  }
-}
-
-// Update tab checkbox state based on column checkbox states
+// Update tab checkbox state based on the tab's enable elements
 static void update_tab_checkbox_state(struct tab_checkbox_data *data) {
-  if (data->updating)
+  if (data->updating || data->elems->len == 0)
     return;
 
-  // count how many column checkboxes are in each state
-  int all_enabled = 0;
-  int all_disabled = 0;
-  int columns_exist = 0;
+  int enabled_count = 0;
 
-  // Use columns array if present, otherwise fall back to left/right
-  if (data->columns) {
-    for (int i = 0; i < data->columns->len; i++) {
-      struct column_checkbox_data *col = g_array_index(
-        data->columns, struct column_checkbox_data *, i
-      );
-      count_column_state(col, &all_enabled, &all_disabled, &columns_exist);
-    }
-  } else {
-    count_column_state(data->left_column, &all_enabled, &all_disabled, &columns_exist);
-    count_column_state(data->right_column, &all_enabled, &all_disabled, &columns_exist);
+  for (int i = 0; i < data->elems->len; i++) {
+    struct alsa_elem *elem = g_array_index(data->elems, struct alsa_elem *, i);
+    if (alsa_get_elem_value(elem))
+      enabled_count++;
   }
 
-  if (columns_exist == 0)
-    return;
-
   data->updating = 1;
 
   GtkCheckButton *check = GTK_CHECK_BUTTON(data->tab_checkbox);
 
-  if (all_disabled == columns_exist) {
-    // all columns are disabled
+  if (enabled_count == 0) {
+    // all disabled
     gtk_check_button_set_active(check, FALSE);
     gtk_check_button_set_inconsistent(check, FALSE);
     data->was_inconsistent = 0;
-  } else if (all_enabled == columns_exist) {
-    // all columns are enabled
+  } else if (enabled_count == data->elems->len) {
+    // all enabled
     gtk_check_button_set_active(check, TRUE);
     gtk_check_button_set_inconsistent(check, FALSE);
     data->was_inconsistent = 0;
@@ -195,38 +173,28 @@ static void update_tab_checkbox_state(struct tab_checkbox_data *data) {
   data->updating = 0;
 }
 
-// Callback when a column checkbox changes (need to update tab checkbox)
+// Callback when one of the tab's enable elements changes
 static void tab_child_enable_changed(struct alsa_elem *elem, void *private) {
   struct tab_checkbox_data *data = private;
   update_tab_checkbox_state(data);
 }
 
 // Helper to set column state from tab checkbox toggle
+// (the tab checkbox sets the elements themselves)
 static void set_column_state(struct column_checkbox_data *col, gboolean new_state) {
-  if (!col || !col->child_elems)
-    return;
-
   col->was_inconsistent = 0;
 
-  // Directly set all child elements to the target state
-  for (int i = 0; i < col->child_elems->len; i++) {
-    struct alsa_elem *elem = g_array_index(
-      col->child_elems, struct alsa_elem *, i
-    );
-    alsa_set_elem_value(elem, new_state ? 1 : 0);
-  }
-
   // Update the column checkbox UI to match
-  if (col->column_checkbox) {
-    gtk_check_button_set_inconsistent(
-      GTK_CHECK_BUTTON(col->column_checkbox),
-      FALSE
-    );
-    gtk_check_button_set_active(
-      GTK_CHECK_BUTTON(col->column_checkbox),
-      new_state
-    );
-  }
+  col->updating = 1;
+  gtk_check_button_set_inconsistent(
+    GTK_CHECK_BUTTON(col->column_checkbox),
+    FALSE
+  );
+  gtk_check_button_set_active(
+    GTK_CHECK_BUTTON(col->column_checkbox),
+    new_state
+  );
+  col->updating = 0;
 }
 
 // Callback when tab checkbox is clicked
@@ -251,17 +219,18 @@ static void tab_checkbox_toggled(GtkCheckButton *button, gpointer user_data) {
     new_state = active;  // toggle normally
   }
 
-  // Set all column checkboxes to the same state
-  if (data->columns) {
-    for (int i = 0; i < data->columns->len; i++) {
-      struct column_checkbox_data *col = g_array_index(
-        data->columns, struct column_checkbox_data *, i
-      );
-      set_column_state(col, new_state);
-    }
-  } else {
-    set_column_state(data->left_column, new_state);
-    set_column_state(data->right_column, new_state);
+  // Set all the tab's elements to the new state
+  for (int i = 0; i < data->elems->len; i++) {
+    struct alsa_elem *elem = g_array_index(data->elems, struct alsa_elem *, i);
+    alsa_set_elem_value(elem, new_state ? 1 : 0);
+  }
+
+  // Set all column checkboxes (if built) to the same state
+  for (int i = 0; i < data->columns->len; i++) {
+    struct column_checkbox_data *col = g_array_index(
+      data->columns, struct column_checkbox_data *, i
+    );
+    set_column_state(col, new_state);
   }
 
   // clear tab inconsistent state
@@ -1445,12 +1414,11 @@ static int has_io_for_category(
 // Create a single column for mixer inputs filtered by source type
 // Returns the column_checkbox_data, adds vbox to parent hbox
 static struct column_checkbox_data *create_mixer_input_column(
-  GtkWidget                *parent_hbox,
-  struct alsa_card         *card,
-  const char               *label_text,
-  int                       src_port_category,
-  int                       src_hw_type,
-  struct tab_checkbox_data *tab_data
+  GtkWidget        *parent_hbox,
+  struct alsa_card *card,
+  const char       *label_text,
+  int               src_port_category,
+  int               src_hw_type
 ) {
   GtkWidget *vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
 
@@ -1488,12 +1456,6 @@ static struct column_checkbox_data *create_mixer_input_column(
   gtk_box_append(GTK_BOX(vbox), grid);
   gtk_box_append(GTK_BOX(parent_hbox), vbox);
 
-  // Register callbacks from children to update tab checkbox
-  for (int i = 0; i < col_data->child_elems->len; i++) {
-    struct alsa_elem *elem = g_array_index(col_data->child_elems, struct alsa_elem *, i);
-    alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-  }
-
   // Update column checkbox initial state
   update_column_checkbox_state(col_data);
 
@@ -1507,14 +1469,15 @@ static struct column_checkbox_data *create_mixer_input_column(
   return col_data;
 }
 
-// Create a two-column layout with column checkboxes
+// Create a two-column layout with column checkboxes, adding the
+// columns to tab_data
 // Returns the box containing both columns
 static GtkWidget *create_two_column_layout(
   GtkWidget                    **left_grid,      // returns the left grid
   GtkWidget                    **right_grid,     // returns the right grid
   struct column_checkbox_data  **left_col_data,  // returns left column data
   struct column_checkbox_data  **right_col_data, // returns right column data
-  struct tab_checkbox_data     **tab_data,       // returns tab checkbox data
+  struct tab_checkbox_data      *tab_data,
   int                            show_left,
   int                            show_right,
   const char                    *left_label_text,
@@ -1526,11 +1489,6 @@ static GtkWidget *create_two_column_layout(
   gtk_widget_set_margin_top(hbox, 20);
   gtk_widget_set_margin_bottom(hbox, 20);
 
-  // Create tab checkbox data structure
-  struct tab_checkbox_data *tab_checkbox_data = g_malloc0(sizeof(struct tab_checkbox_data));
-  tab_checkbox_data->updating = 0;
-  *tab_data = tab_checkbox_data;
-
   // Left column
   if (show_left) {
     GtkWidget *left_vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
@@ -1565,7 +1523,7 @@ static GtkWidget *create_two_column_layout(
     gtk_box_append(GTK_BOX(hbox), left_vbox);
 
     *left_col_data = col_data;
-    tab_checkbox_data->left_column = col_data;
+    g_array_append_val(tab_data->columns, col_data);
 
     // attach cleanup to the vbox
     g_object_weak_ref(
@@ -1578,7 +1536,6 @@ static GtkWidget *create_two_column_layout(
       *left_grid = NULL;
     if (left_col_data)
       *left_col_data = NULL;
-    tab_checkbox_data->left_column = NULL;
   }
 
   // Right column
@@ -1615,7 +1572,7 @@ static GtkWidget *create_two_column_layout(
     gtk_box_append(GTK_BOX(hbox), right_vbox);
 
     *right_col_data = col_data;
-    tab_checkbox_data->right_column = col_data;
+    g_array_append_val(tab_data->columns, col_data);
 
     // attach cleanup to the vbox
     g_object_weak_ref(
@@ -1628,12 +1585,130 @@ static GtkWidget *create_two_column_layout(
       *right_grid = NULL;
     if (right_col_data)
       *right_col_data = NULL;
-    tab_checkbox_data->right_column = NULL;
   }
 
   return hbox;
 }
 
+// Create the data for an I/O sub-tab
+static struct tab_checkbox_data *new_tab_checkbox_data(
+  int         port_category,
+  int         hw_type,
+  const char *tab_name
+) {
+  struct tab_checkbox_data *tab_data = g_malloc0(sizeof(struct tab_checkbox_data));
+  tab_data->elems = g_array_new(FALSE, FALSE, sizeof(struct alsa_elem *));
+  tab_data->columns = g_array_new(FALSE, FALSE, sizeof(struct column_checkbox_data *));
+  tab_data->port_category = port_category;
+  tab_data->hw_type = hw_type;
+  tab_data->tab_name = tab_name;
+  tab_data->show_inputs = 1;
+  tab_data->show_outputs = 1;
+  return tab_data;
+}
+
+// Add the enable elements of the sources that
+// add_src_names_for_category() shows
+static void add_src_enable_elems(
+  GArray           *elems,
+  struct alsa_card *card,
+  int               port_category,
+  int               hw_type  // only used for PC_HW, -1 for others
+) {
+  for (int i = 0; i < card->routing_srcs->len; i++) {
+    struct routing_src *src = &g_array_index(
+      card->routing_srcs, struct routing_src, i
+    );
+
+    if (src->port_category != port_category)
+      continue;
+    if (port_category == PC_HW && src->hw_type != hw_type)
+      continue;
+    if (!src->custom_name_elem || !src->enable_elem)
+      continue;
+
+    g_array_append_val(elems, src->enable_elem);
+  }
+}
+
+// Add the enable elements of the sinks that
+// add_snk_names_for_category() (if names is set) or
+// add_snk_enables_for_category() shows
+static void add_snk_enable_elems(
+  GArray           *elems,
+  struct alsa_card *card,
+  int               port_category,
+  int               hw_type,  // only used for PC_HW, -1 for others
+  int               names
+) {
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+
+    if (snk->elem->port_category != port_category)
+      continue;
+    if (port_category == PC_HW && snk->elem->hw_type != hw_type)
+      continue;
+    if ((names && !snk->custom_name_elem) || !snk->enable_elem)
+      continue;
+
+    // fixed mixer inputs only have columns for PCM and hardware sources
+    if (port_category == PC_MIX && card->has_fixed_mixer_inputs) {
+      int src_cat, src_hw;
+      get_routing_src_info_for_mixer_snk(card, snk, &src_cat, &src_hw);
+      if (src_cat != PC_PCM && src_cat != PC_HW)
+        continue;
+    }
+
+    g_array_append_val(elems, snk->enable_elem);
+  }
+}
+
+// Append an I/O sub-tab whose contents are built by build when it's
+// first shown; the tab checkbox in its label follows the elements
+// in tab_data->elems until then too
+static void append_io_tab(
+  GtkWidget                *notebook,
+  struct alsa_card         *card,
+  struct tab_checkbox_data *tab_data,
+  const char               *page_id,
+  notebook_page_build_func  build
+) {
+  // Create custom tab label with checkbox
+  GtkWidget *tab_label_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  tab_data->tab_checkbox = gtk_check_button_new();
+  gtk_check_button_set_active(GTK_CHECK_BUTTON(tab_data->tab_checkbox), TRUE);
+  g_signal_connect(
+    tab_data->tab_checkbox,
+    "toggled",
+    G_CALLBACK(tab_checkbox_toggled),
+    tab_data
+  );
+  gtk_box_append(GTK_BOX(tab_label_box), tab_data->tab_checkbox);
+
+  GtkWidget *tab_label_text = gtk_label_new(tab_data->tab_name);
+  gtk_box_append(GTK_BOX(tab_label_box), tab_label_text);
+
+  // Register callbacks from the elements to update tab checkbox
+  for (int i = 0; i < tab_data->elems->len; i++) {
+    struct alsa_elem *elem = g_array_index(tab_data->elems, struct alsa_elem *, i);
+    alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
+  }
+
+  // Update tab checkbox initial state
+  update_tab_checkbox_state(tab_data);
+
+  GtkWidget *page = append_lazy_notebook_page(
+    GTK_NOTEBOOK(notebook), page_id, tab_label_box, build, card
+  );
+
+  // attach cleanup to the page
+  g_object_set_data_full(
+    G_OBJECT(page), IO_TAB_DATA_KEY, tab_data, free_tab_checkbox_data
+  );
+}
+
 // Page IDs for hardware type tabs
 static const char *hw_type_page_ids[] = {
   "analogue",
@@ -1641,25 +1716,20 @@ static const char *hw_type_page_ids[] = {
   "adat"
 };
 
-// Add a hardware tab (Analogue, S/PDIF, or ADAT)
-static void add_hw_tab(
-  GtkWidget        *notebook,
-  struct alsa_card *card,
-  int               hw_type
-) {
+// Build the contents of a hardware tab when first shown
+static void build_hw_tab(GtkWidget *page, struct alsa_card *card) {
+  struct tab_checkbox_data *tab_data =
+    g_object_get_data(G_OBJECT(page), IO_TAB_DATA_KEY);
+  int hw_type = tab_data->hw_type;
   int has_inputs = has_io_for_category(card, PC_HW, hw_type, 1, 0);
   int has_outputs = has_io_for_category(card, PC_HW, hw_type, 0, 1);
 
-  if (!has_inputs && !has_outputs)
-    return;
-
   GtkWidget *left_grid, *right_grid;
   struct column_checkbox_data *left_col_data, *right_col_data;
-  struct tab_checkbox_data *tab_data;
   GtkWidget *content = create_two_column_layout(
     &left_grid, &right_grid,
     &left_col_data, &right_col_data,
-    &tab_data,
+    tab_data,
     has_inputs, has_outputs,
     "Inputs", "Outputs"
   );
@@ -1672,53 +1742,35 @@ static void add_hw_tab(
   if (right_grid)
     add_snk_names_for_category(card, right_grid, PC_HW, hw_type, right_col_data);
 
-  // Register callbacks from children to update tab checkbox
-  if (left_col_data) {
-    for (int i = 0; i < left_col_data->child_elems->len; i++) {
-      struct alsa_elem *elem = g_array_index(left_col_data->child_elems, struct alsa_elem *, i);
-      alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-    }
-  }
-  if (right_col_data) {
-    for (int i = 0; i < right_col_data->child_elems->len; i++) {
-      struct alsa_elem *elem = g_array_index(right_col_data->child_elems, struct alsa_elem *, i);
-      alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-    }
-  }
-
   // Update column checkbox initial states
   if (left_col_data)
     update_column_checkbox_state(left_col_data);
   if (right_col_data)
     update_column_checkbox_state(right_col_data);
 
-  // Create custom tab label with checkbox
-  GtkWidget *tab_label_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
-  tab_data->tab_checkbox = gtk_check_button_new();
-  gtk_check_button_set_active(GTK_CHECK_BUTTON(tab_data->tab_checkbox), TRUE);
-  g_signal_connect(
-    tab_data->tab_checkbox,
-    "toggled",
-    G_CALLBACK(tab_checkbox_toggled),
-    tab_data
-  );
-  gtk_box_append(GTK_BOX(tab_label_box), tab_data->tab_checkbox);
+  gtk_box_append(GTK_BOX(page), wrap_tab_content_scrolled(content));
+}
 
-  GtkWidget *tab_label_text = gtk_label_new(hw_type_names[hw_type]);
-  gtk_box_append(GTK_BOX(tab_label_box), tab_label_text);
+// Add a hardware tab (Analogue, S/PDIF, or ADAT)
+static void add_hw_tab(
+  GtkWidget        *notebook,
+  struct alsa_card *card,
+  int               hw_type
+) {
+  int has_inputs = has_io_for_category(card, PC_HW, hw_type, 1, 0);
+  int has_outputs = has_io_for_category(card, PC_HW, hw_type, 0, 1);
 
-  GtkWidget *scrolled = wrap_tab_content_scrolled(content);
-  g_object_set_data(G_OBJECT(scrolled), PAGE_ID_KEY, (gpointer)hw_type_page_ids[hw_type]);
-  gtk_notebook_append_page(GTK_NOTEBOOK(notebook), scrolled, tab_label_box);
+  if (!has_inputs && !has_outputs)
+    return;
 
-  // Update tab checkbox initial state
-  update_tab_checkbox_state(tab_data);
+  struct tab_checkbox_data *tab_data =
+    new_tab_checkbox_data(PC_HW, hw_type, hw_type_names[hw_type]);
 
-  // attach cleanup to the content
-  g_object_weak_ref(
-    G_OBJECT(content),
-    (GWeakNotify)free_tab_checkbox_data,
-    tab_data
+  add_src_enable_elems(tab_data->elems, card, PC_HW, hw_type);
+  add_snk_enable_elems(tab_data->elems, card, PC_HW, hw_type, 1);
+
+  append_io_tab(
+    notebook, card, tab_data, hw_type_page_ids[hw_type], build_hw_tab
   );
 }
 
@@ -1730,21 +1782,16 @@ static const char *get_category_page_id(const char *tab_name) {
   return tab_name;
 }
 
-// Add a non-hardware tab (PCM, Mixer, DSP)
-static void add_category_tab(
-  GtkWidget        *notebook,
-  struct alsa_card *card,
-  int               port_category,
-  const char       *tab_name,
-  int               show_inputs,
-  int               show_outputs
-) {
-  if (!has_io_for_category(card, port_category, -1, show_inputs, show_outputs))
-    return;
+// Build the contents of a non-hardware tab when first shown
+static void build_category_tab(GtkWidget *page, struct alsa_card *card) {
+  struct tab_checkbox_data *tab_data =
+    g_object_get_data(G_OBJECT(page), IO_TAB_DATA_KEY);
+  int port_category = tab_data->port_category;
+  int show_inputs = tab_data->show_inputs;
+  int show_outputs = tab_data->show_outputs;
 
   GtkWidget *left_grid, *right_grid;
   struct column_checkbox_data *left_col_data, *right_col_data;
-  struct tab_checkbox_data *tab_data;
 
   // PCM: sources (outputs) on left, sinks (inputs) on right
   // Others: sinks (inputs) on left, sources (outputs) on right
@@ -1753,7 +1800,7 @@ static void add_category_tab(
   GtkWidget *content = create_two_column_layout(
     &left_grid, &right_grid,
     &left_col_data, &right_col_data,
-    &tab_data,
+    tab_data,
     pcm ? show_outputs : show_inputs,
     pcm ? show_inputs : show_outputs,
     pcm ? "Outputs" : "Inputs",
@@ -1792,81 +1839,50 @@ static void add_category_tab(
       );
   }
 
-  // Register callbacks from children to update tab checkbox
-  if (left_col_data) {
-    for (int i = 0; i < left_col_data->child_elems->len; i++) {
-      struct alsa_elem *elem = g_array_index(left_col_data->child_elems, struct alsa_elem *, i);
-      alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-    }
-  }
-  if (right_col_data) {
-    for (int i = 0; i < right_col_data->child_elems->len; i++) {
-      struct alsa_elem *elem = g_array_index(right_col_data->child_elems, struct alsa_elem *, i);
-      alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-    }
-  }
-
   // Update column checkbox initial states
   if (left_col_data)
     update_column_checkbox_state(left_col_data);
   if (right_col_data)
     update_column_checkbox_state(right_col_data);
 
-  // Create custom tab label with checkbox
-  GtkWidget *tab_label_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
-  tab_data->tab_checkbox = gtk_check_button_new();
-  gtk_check_button_set_active(GTK_CHECK_BUTTON(tab_data->tab_checkbox), TRUE);
-  g_signal_connect(
-    tab_data->tab_checkbox,
-    "toggled",
-    G_CALLBACK(tab_checkbox_toggled),
-    tab_data
-  );
-  gtk_box_append(GTK_BOX(tab_label_box), tab_data->tab_checkbox);
+  gtk_box_append(GTK_BOX(page), wrap_tab_content_scrolled(content));
+}
 
-  GtkWidget *tab_label_text = gtk_label_new(tab_name);
-  gtk_box_append(GTK_BOX(tab_label_box), tab_label_text);
+// Add a non-hardware tab (PCM, Mixer, DSP)
+static void add_category_tab(
+  GtkWidget        *notebook,
+  struct alsa_card *card,
+  int               port_category,
+  const char       *tab_name,
+  int               show_inputs,
+  int               show_outputs
+) {
+  if (!has_io_for_category(card, port_category, -1, show_inputs, show_outputs))
+    return;
 
-  GtkWidget *scrolled = wrap_tab_content_scrolled(content);
-  g_object_set_data(
-    G_OBJECT(scrolled), PAGE_ID_KEY, (gpointer)get_category_page_id(tab_name)
-  );
-  gtk_notebook_append_page(GTK_NOTEBOOK(notebook), scrolled, tab_label_box);
+  struct tab_checkbox_data *tab_data =
+    new_tab_checkbox_data(port_category, -1, tab_name);
+  tab_data->show_inputs = show_inputs;
+  tab_data->show_outputs = show_outputs;
 
-  // Update tab checkbox initial state
-  update_tab_checkbox_state(tab_data);
+  if (show_inputs)
+    add_snk_enable_elems(
+      tab_data->elems, card, port_category, -1, port_category != PC_DSP
+    );
+  if (show_outputs)
+    add_src_enable_elems(tab_data->elems, card, port_category, -1);
 
-  // attach cleanup to the content
-  g_object_weak_ref(
-    G_OBJECT(content),
-    (GWeakNotify)free_tab_checkbox_data,
-    tab_data
+  append_io_tab(
+    notebook, card, tab_data, get_category_page_id(tab_name),
+    build_category_tab
   );
 }
 
-// Add the Mixer tab with special handling for fixed vs non-fixed mixer inputs
-static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
-  if (!has_io_for_category(card, PC_MIX, -1, 1, 1))
-    return;
-
-  // Register callbacks on all source custom names to update mixer labels
-  // Do this once for all mixer inputs before creating them
-  for (int i = 0; i < card->routing_srcs->len; i++) {
-    struct routing_src *r_src = &g_array_index(
-      card->routing_srcs, struct routing_src, i
-    );
-    if (r_src->custom_name_elem) {
-      alsa_elem_add_callback(
-        r_src->custom_name_elem,
-        source_name_changed_update_mixer_labels,
-        NULL,
-        NULL
-      );
-    }
-  }
-
+// Build the contents of the Mixer tab when first shown
+static void build_mixer_tab(GtkWidget *page, struct alsa_card *card) {
+  struct tab_checkbox_data *tab_data =
+    g_object_get_data(G_OBJECT(page), IO_TAB_DATA_KEY);
   GtkWidget *content;
-  struct tab_checkbox_data *tab_data;
 
   if (card->has_fixed_mixer_inputs) {
     // For fixed mixer inputs, create multiple columns by source type
@@ -1876,18 +1892,13 @@ static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
     gtk_widget_set_margin_top(content, 20);
     gtk_widget_set_margin_bottom(content, 20);
 
-    // Create tab checkbox data structure
-    tab_data = g_malloc0(sizeof(struct tab_checkbox_data));
-    tab_data->updating = 0;
-    tab_data->columns = g_array_new(FALSE, FALSE, sizeof(struct column_checkbox_data *));
-
     // Labels for hardware input types
     const char *hw_labels[] = {"Analogue Inputs", "S/PDIF Inputs", "ADAT Inputs"};
 
     // PCM Outputs column (playback from computer)
     if (has_mixer_inputs_for_src_type(card, PC_PCM, -1)) {
       struct column_checkbox_data *col = create_mixer_input_column(
-        content, card, "PCM Outputs", PC_PCM, -1, tab_data
+        content, card, "PCM Outputs", PC_PCM, -1
       );
       g_array_append_val(tab_data->columns, col);
     }
@@ -1896,7 +1907,7 @@ static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
     for (int hw_type = 0; hw_type < HW_TYPE_COUNT; hw_type++) {
       if (has_mixer_inputs_for_src_type(card, PC_HW, hw_type)) {
         struct column_checkbox_data *col = create_mixer_input_column(
-          content, card, hw_labels[hw_type], PC_HW, hw_type, tab_data
+          content, card, hw_labels[hw_type], PC_HW, hw_type
         );
         g_array_append_val(tab_data->columns, col);
       }
@@ -1939,12 +1950,6 @@ static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
       gtk_box_append(GTK_BOX(vbox), grid);
       gtk_box_append(GTK_BOX(content), vbox);
 
-      // Register callbacks from children to update tab checkbox
-      for (int i = 0; i < col_data->child_elems->len; i++) {
-        struct alsa_elem *elem = g_array_index(col_data->child_elems, struct alsa_elem *, i);
-        alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-      }
-
       update_column_checkbox_state(col_data);
       g_array_append_val(tab_data->columns, col_data);
 
@@ -1962,7 +1967,7 @@ static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
     content = create_two_column_layout(
       &left_grid, &right_grid,
       &left_col_data, &right_col_data,
-      &tab_data,
+      tab_data,
       1, 1,
       "Inputs", "Outputs"
     );
@@ -1975,20 +1980,6 @@ static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
     if (right_grid)
       add_src_names_for_category(card, right_grid, PC_MIX, -1, right_col_data);
 
-    // Register callbacks from children to update tab checkbox
-    if (left_col_data) {
-      for (int i = 0; i < left_col_data->child_elems->len; i++) {
-        struct alsa_elem *elem = g_array_index(left_col_data->child_elems, struct alsa_elem *, i);
-        alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-      }
-    }
-    if (right_col_data) {
-      for (int i = 0; i < right_col_data->child_elems->len; i++) {
-        struct alsa_elem *elem = g_array_index(right_col_data->child_elems, struct alsa_elem *, i);
-        alsa_elem_add_callback(elem, tab_child_enable_changed, tab_data, NULL);
-      }
-    }
-
     // Update column checkbox initial states
     if (left_col_data)
       update_column_checkbox_state(left_col_data);
@@ -1996,34 +1987,26 @@ static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
       update_column_checkbox_state(right_col_data);
   }
 
-  // Create custom tab label with checkbox
-  GtkWidget *tab_label_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
-  tab_data->tab_checkbox = gtk_check_button_new();
-  gtk_check_button_set_active(GTK_CHECK_BUTTON(tab_data->tab_checkbox), TRUE);
-  g_signal_connect(
-    tab_data->tab_checkbox,
-    "toggled",
-    G_CALLBACK(tab_checkbox_toggled),
-    tab_data
-  );
-  gtk_box_append(GTK_BOX(tab_label_box), tab_data->tab_checkbox);
+  gtk_box_append(GTK_BOX(page), wrap_tab_content_scrolled(content));
+}
 
-  GtkWidget *tab_label_text = gtk_label_new("Mixer");
-  gtk_box_append(GTK_BOX(tab_label_box), tab_label_text);
+// Add the Mixer tab with special handling for fixed vs non-fixed mixer inputs
+static void add_mixer_tab(GtkWidget *notebook, struct alsa_card *card) {
+  if (!has_io_for_category(card, PC_MIX, -1, 1, 1))
+    return;
 
-  GtkWidget *scrolled = wrap_tab_content_scrolled(content);
-  g_object_set_data(G_OBJECT(scrolled), PAGE_ID_KEY, (gpointer)"mixer");
-  gtk_notebook_append_page(GTK_NOTEBOOK(notebook), scrolled, tab_label_box);
+  struct tab_checkbox_data *tab_data =
+    new_tab_checkbox_data(PC_MIX, -1, "Mixer");
 
-  // Update tab checkbox initial state
-  update_tab_checkbox_state(tab_data);
+  add_snk_enable_elems(tab_data->elems, card, PC_MIX, -1, 0);
 
-  // attach cleanup to the content
-  g_object_weak_ref(
-    G_OBJECT(content),
-    (GWeakNotify)free_tab_checkbox_data,
-    tab_data
-  );
+  // (with fixed mixer inputs, the Outputs column is only there if
+  // the mixer has named outputs)
+  if (!card->has_fixed_mixer_inputs ||
+      has_io_for_category(card, PC_MIX, -1, 0, 1))
+    add_src_enable_elems(tab_data->elems, card, PC_MIX, -1);
+
+  append_io_tab(notebook, card, tab_data, "mixer", build_mixer_tab);
 }
 
 // Update all config-io mixer/DSP input pair labels
@@ -2056,7 +2039,38 @@ void update_config_io_mixer_labels(struct alsa_card *card) {
   }
 }
 
-void add_io_tab(GtkWidget *top_notebook, struct alsa_card *card) {
+void add_config_io_source_name_callbacks(struct alsa_card *card) {
+  if (!has_io_for_category(card, PC_MIX, -1, 1, 1))
+    return;
+
+  // Register callbacks on all source custom names to update mixer labels
+  for (int i = 0; i < card->routing_srcs->len; i++) {
+    struct routing_src *r_src = &g_array_index(
+      card->routing_srcs, struct routing_src, i
+    );
+    if (r_src->custom_name_elem) {
+      alsa_elem_add_callback(
+        r_src->custom_name_elem,
+        source_name_changed_update_mixer_labels,
+        NULL,
+        NULL
+      );
+    }
+  }
+}
+
+// Check if the I/O Configuration tab would have any sub-tabs
+static int has_io_tabs(struct alsa_card *card) {
+  for (int hw_type = 0; hw_type < HW_TYPE_COUNT; hw_type++)
+    if (has_io_for_category(card, PC_HW, hw_type, 1, 1))
+      return 1;
+
+  return has_io_for_category(card, PC_PCM, -1, 1, 1) ||
+         has_io_for_category(card, PC_DSP, -1, 1, 1) ||
+         has_io_for_category(card, PC_MIX, -1, 1, 1);
+}
+
+static void build_io_tab(GtkWidget *page, struct alsa_card *card) {
   // Create the sub-notebook for I/O Configuration
   GtkWidget *notebook = gtk_notebook_new();
 
@@ -2070,31 +2084,33 @@ void add_io_tab(GtkWidget *top_notebook, struct alsa_card *card) {
   add_category_tab(notebook, card, PC_DSP, "DSP", 1, 1);
   add_mixer_tab(notebook, card);
 
+  GtkWidget *io_tab_content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+  gtk_widget_set_margin_top(io_tab_content, 20);
+
+  gtk_box_append(GTK_BOX(io_tab_content), config_help_label(
+    "Use the checkboxes to hide unused inputs and outputs from the display.\n"
+    "You can also give each port a custom name to help identify it.\n"
+    "Use the link buttons to pair adjacent channels as stereo."
+  ));
+
+  gtk_widget_set_vexpand(notebook, TRUE);
+  gtk_box_append(GTK_BOX(io_tab_content), notebook);
+
+  // Restore saved I/O tab and connect signal to save tab changes
+  setup_notebook_tab_persistence(
+    GTK_NOTEBOOK(notebook), card, CONFIG_IO_TAB_KEY
+  );
+
+  gtk_box_append(GTK_BOX(page), io_tab_content);
+}
+
+void add_io_tab(GtkWidget *top_notebook, struct alsa_card *card) {
   // I/O tab (only if there are any sub-tabs)
-  if (gtk_notebook_get_n_pages(GTK_NOTEBOOK(notebook)) > 0) {
-    GtkWidget *io_tab_content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
-    gtk_widget_set_margin_top(io_tab_content, 20);
-
-    gtk_box_append(GTK_BOX(io_tab_content), config_help_label(
-      "Use the checkboxes to hide unused inputs and outputs from the display.\n"
-      "You can also give each port a custom name to help identify it.\n"
-      "Use the link buttons to pair adjacent channels as stereo."
-    ));
-
-    gtk_widget_set_vexpand(notebook, TRUE);
-    gtk_box_append(GTK_BOX(io_tab_content), notebook);
-
-    // Restore saved I/O tab and connect signal to save tab changes
-    setup_notebook_tab_persistence(
-      GTK_NOTEBOOK(notebook), card, CONFIG_IO_TAB_KEY
-    );
+  if (!has_io_tabs(card))
+    return;
 
-    GtkWidget *io_tab_label = gtk_label_new("I/O Configuration");
-    g_object_set_data(
-      G_OBJECT(io_tab_content), PAGE_ID_KEY, (gpointer)"io-config"
-    );
-    gtk_notebook_append_page(
-      GTK_NOTEBOOK(top_notebook), io_tab_content, io_tab_label
-    );
-  }
+  append_lazy_notebook_page(
+    GTK_NOTEBOOK(top_notebook), "io-config",
+    gtk_label_new("I/O Configuration"), build_io_tab, card
+  );
 }
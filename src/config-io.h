@@ -9,3 +9,7 @@
 
 void add_io_tab(GtkWidget *top_notebook, struct alsa_card *card);
 void update_config_io_mixer_labels(struct alsa_card *card);
+
+// Register the source name callbacks that refresh mixer input labels
+// (independent of whether the Configuration window has been built)
+void add_config_io_source_name_callbacks(struct alsa_card *card);
@@ -514,10 +514,10 @@ static GtkWidget *create_main_alt_group_grid(struct alsa_card *card) {
   return grid;
 }
 
-void add_monitor_groups_tab(GtkWidget *notebook, struct alsa_card *card) {
-  if (!get_elem_by_prefix(card->elems, "Main Group Output"))
-    return;
-
+static void build_monitor_groups_tab(
+  GtkWidget        *page,
+  struct alsa_card *card
+) {
   GtkWidget *content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
   gtk_widget_set_margin_start(content, 20);
   gtk_widget_set_margin_end(content, 20);
@@ -545,12 +545,16 @@ void add_monitor_groups_tab(GtkWidget *notebook, struct alsa_card *card) {
   card->monitor_groups_grid = grid;
 
   GtkWidget *scrolled = wrap_tab_content_scrolled(content);
-  g_object_set_data(
-    G_OBJECT(scrolled), PAGE_ID_KEY, (gpointer)"monitor-groups"
-  );
-  gtk_notebook_append_page(
-    GTK_NOTEBOOK(notebook), scrolled,
-    gtk_label_new("Monitor Groups")
+  gtk_box_append(GTK_BOX(page), scrolled);
+}
+
+void add_monitor_groups_tab(GtkWidget *notebook, struct alsa_card *card) {
+  if (!get_elem_by_prefix(card->elems, "Main Group Output"))
+    return;
+
+  append_lazy_notebook_page(
+    GTK_NOTEBOOK(notebook), "monitor-groups",
+    gtk_label_new("Monitor Groups"), build_monitor_groups_tab, card
   );
 }
 
@@ -1,11 +1,16 @@
 // SPDX-FileCopyrightText: 2022-2025 Geoffrey D. Bennett <g@b4.vu>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <sys/stat.h>
+
 #include "alsa.h"
 #include "alsa-sim.h"
+#include "debug.h"
 #include "error.h"
 #include "file.h"
 #include "optional-state.h"
+#include "port-enable.h"
+#include "state-writer.h"
 #include "stringhelper.h"
 
 static void run_alsactl(
@@ -66,34 +71,47 @@ done:
     g_error_free(error);
 }
 
-// Convert element value to string for saving
+// Get an element's value without reading the hardware
+// The single values and multi-valued integers/booleans are kept up
+// to date from the ALSA events; enums with several values don't
+// share that storage so are read
+static long get_cached_elem_value(struct alsa_elem *elem) {
+  if (elem->count == 1)
+    return elem->value;
+
+  if (elem->values && elem->type != SND_CTL_ELEM_TYPE_ENUMERATED)
+    return elem->values[elem->index];
+
+  return alsa_get_elem_value(elem);
+}
+
+// Convert element value to string for saving and comparing
 static char *elem_value_to_string(struct alsa_elem *elem) {
   int type = elem->type;
 
   if (type == SND_CTL_ELEM_TYPE_BOOLEAN) {
-    return g_strdup(alsa_get_elem_value(elem) ? "true" : "false");
+    return g_strdup(get_cached_elem_value(elem) ? "true" : "false");
   } else if (type == SND_CTL_ELEM_TYPE_ENUMERATED) {
-    long value = alsa_get_elem_value(elem);
-    char *item_name = alsa_get_item_name(elem, value);
+    const char *item_name = alsa_peek_item_name(
+      elem, get_cached_elem_value(elem)
+    );
     return g_strdup(item_name ? item_name : "");
   } else if (type == SND_CTL_ELEM_TYPE_INTEGER) {
     int count = elem->count;
 
     // single value
     if (count <= 1)
-      return g_strdup_printf("%ld", alsa_get_elem_value(elem));
+      return g_strdup_printf("%ld", get_cached_elem_value(elem));
 
-    // multi-valued: get all values and format as comma-separated
-    long *values = alsa_get_elem_int_values(elem);
+    // multi-valued: format the cached values as comma-separated
     GString *str = g_string_new(NULL);
 
     for (int i = 0; i < count; i++) {
       if (i > 0)
         g_string_append_c(str, ',');
-      g_string_append_printf(str, "%ld", values[i]);
+      g_string_append_printf(str, "%ld", elem->values ? elem->values[i] : 0);
     }
 
-    free(values);
     return g_string_free(str, FALSE);
   } else if (type == SND_CTL_ELEM_TYPE_BYTES) {
     // bytes type used for custom names - treat as string
@@ -111,22 +129,76 @@ static char *elem_value_to_string(struct alsa_elem *elem) {
 }
 
 // Check if element should be saved (skip volatile/read-only elements)
+// Uses the flags cached in the element
 static int should_save_elem(struct alsa_elem *elem) {
   // skip volatile elements like level meters
-  if (alsa_get_elem_volatile(elem))
+  if (elem->is_volatile)
     return 0;
 
   // skip non-writable elements (read-only status values)
-  if (!alsa_get_elem_writable(elem))
+  if (!elem->is_writable)
     return 0;
 
   return 1;
 }
 
-// Save card configuration to native format
-int save_native(struct alsa_card *card, const char *path) {
+static char *build_native_snapshot(
+  struct alsa_card *card,
+  const char       *path,
+  gsize            *size
+);
+static void write_native_snapshot(
+  const char *path,
+  char       *snapshot,
+  gsize       size
+);
+
+struct save_native_data {
+  GtkWidget *window;
+
+  // for save_native_with_snapshot(), the snapshot to write once the
+  // keyfile has been
+  char      *path;
+  char      *snapshot;
+  gsize      snapshot_size;
+};
+
+// Report a failed save_native() write, if the window is still open;
+// on success, write the snapshot (if any) for the new keyfile
+static void save_native_done(const GError *error, gpointer user_data) {
+  struct save_native_data *data = user_data;
+
+  if (error) {
+    char *msg = g_strdup_printf("Error saving: %s", error->message);
+    show_error(data->window ? GTK_WINDOW(data->window) : NULL, msg);
+    g_free(msg);
+  } else if (data->snapshot) {
+    write_native_snapshot(data->path, data->snapshot, data->snapshot_size);
+  }
+
+  if (data->window)
+    g_object_remove_weak_pointer(
+      G_OBJECT(data->window), (gpointer *)&data->window
+    );
+  g_free(data->path);
+  g_free(data->snapshot);
+  g_free(data);
+}
+
+// Save card configuration to native format, and its snapshot if
+// with_snapshot is set
+// The element values are taken from the cached state in one pass
+// (only custom name bytes are read from the hardware); the file is
+// written in the background and errors are reported to the user when
+// it finishes
+static void save_native_file(
+  struct alsa_card *card,
+  const char       *path,
+  int               with_snapshot
+) {
+  gint64 start_time = g_get_monotonic_time();
   GKeyFile *key_file = g_key_file_new();
-  GError *error = NULL;
+  int saved = 0;
 
   // add device section
   if (card->serial && *card->serial)
@@ -157,18 +229,42 @@ int save_native(struct alsa_card *card, const char *path) {
     );
 
     g_free(value_str);
+    saved++;
   }
 
-  // save to file
-  int ret = 0;
-  if (!g_key_file_save_to_file(key_file, path, &error)) {
-    ret = -1;
-    if (error)
-      g_error_free(error);
+  if (debug_enabled("save"))
+    printf(
+      "SAVE: %s: %d of %d controls in %.1f ms\n",
+      path, saved, card->elems->len,
+      (g_get_monotonic_time() - start_time) / 1000.0
+    );
+
+  // save to file; the snapshot is built now so that it has the same
+  // values, but only written once the keyfile has been
+  struct save_native_data *data = g_malloc0(sizeof(struct save_native_data));
+
+  data->window = card->window_main;
+  if (data->window)
+    g_object_add_weak_pointer(
+      G_OBJECT(data->window), (gpointer *)&data->window
+    );
+
+  if (with_snapshot) {
+    data->path = g_strdup(path);
+    data->snapshot = build_native_snapshot(
+      card, path, &data->snapshot_size
+    );
   }
 
-  g_key_file_free(key_file);
-  return ret;
+  state_writer_save(key_file, path, save_native_done, data);
+}
+
+void save_native(struct alsa_card *card, const char *path) {
+  save_native_file(card, path, 0);
+}
+
+void save_native_with_snapshot(struct alsa_card *card, const char *path) {
+  save_native_file(card, path, 1);
 }
 
 // Convert string value back to element value (single value)
@@ -189,7 +285,7 @@ static int string_to_elem_value(
     // find the enum item by name
     int count = alsa_get_item_count(elem);
     for (int i = 0; i < count; i++) {
-      char *item_name = alsa_get_item_name(elem, i);
+      const char *item_name = alsa_peek_item_name(elem, i);
       if (item_name && strcmp(item_name, str) == 0) {
         *value = i;
         return 0;
@@ -216,13 +312,80 @@ static int string_to_elem_value(
   return -1;
 }
 
-// Set element value from string, handling multi-valued elements
-static void set_elem_from_string(struct alsa_elem *elem, const char *str) {
-  int type = elem->type;
+// Load order of the controls; controls which can change whether
+// others are writable (output volume control SW/HW selectors, enable
+// switches, and modes) are set first, then the other switches and
+// enums, then the values which they may unlock
+enum load_rank {
+  LOAD_RANK_GATE,
+  LOAD_RANK_SWITCH,
+  LOAD_RANK_VALUE,
+  LOAD_RANK_COUNT
+};
+
+static const char *load_gate_patterns[] = {
+  "Volume Control",
+  "Enable",
+  " Mode ",
+  NULL
+};
+
+static int get_load_rank(struct alsa_elem *elem) {
+  for (const char **pattern = load_gate_patterns; *pattern; pattern++)
+    if (strstr(elem->name, *pattern))
+      return LOAD_RANK_GATE;
+
+  if (elem->is_routing_snk ||
+      elem->type == SND_CTL_ELEM_TYPE_INTEGER ||
+      elem->type == SND_CTL_ELEM_TYPE_BYTES)
+    return LOAD_RANK_VALUE;
+
+  return LOAD_RANK_SWITCH;
+}
+
+struct native_control {
+
+  // the name until resolved, then the element
+  gchar            *name;
+  struct alsa_elem *elem;
+
+  gchar            *value;
+
+  // the value parsed for the element; NULL for bytes, which are
+  // compared and set as the string
+  long             *values;
+  int               n_values;
+
+  // from a snapshot, the type of the element it was saved from
+  int               type;
+};
+
+struct native_config {
+  struct native_control *controls;
+  int                    count;
+
+  // keys with no matching element or an unparseable value
+  int                    unknown;
+
+  // if read from a snapshot, the mapping which the names and values
+  // point into, and the values if they had to be converted to long
+  GMappedFile           *snapshot;
+  long                  *snapshot_values;
+};
+
+// Parse a control's value for its element; returns -1 if it can't
+// be parsed
+static int parse_control_value(struct native_control *control) {
+  struct alsa_elem *elem = control->elem;
+  const char *str = control->value;
+
+  // bytes type for custom names
+  if (elem->type == SND_CTL_ELEM_TYPE_BYTES)
+    return 0;
 
   // for multi-valued integers, parse comma-separated values
-  if (type == SND_CTL_ELEM_TYPE_INTEGER && elem->count > 1) {
-    long *values = calloc(elem->count, sizeof(long));
+  if (elem->type == SND_CTL_ELEM_TYPE_INTEGER && elem->count > 1) {
+    long *values = g_malloc0(elem->count * sizeof(long));
     const char *p = str;
     int i = 0;
 
@@ -237,90 +400,799 @@ static void set_elem_from_string(struct alsa_elem *elem, const char *str) {
         p++;
     }
 
-    if (i > 0) {
-      alsa_set_elem_int_values(elem, values, i);
-      alsa_elem_change(elem);
+    if (!i) {
+      g_free(values);
+      return -1;
     }
 
-    free(values);
-    return;
+    control->values = values;
+    control->n_values = i;
+    return 0;
   }
 
+  // single value
+  long value;
+  if (string_to_elem_value(elem, str, &value) < 0)
+    return -1;
+
+  control->values = g_malloc(sizeof(long));
+  control->values[0] = value;
+  control->n_values = 1;
+  return 0;
+}
+
+// Check whether a control's value is already set
+static int control_is_current(struct native_control *control) {
+  struct alsa_elem *elem = control->elem;
+
+  if (!control->values) {
+    char *current = elem_value_to_string(elem);
+    int same = current && !strcmp(current, control->value);
+
+    g_free(current);
+    return same;
+  }
+
+  if (elem->type == SND_CTL_ELEM_TYPE_INTEGER && elem->count > 1)
+    return elem->values &&
+           !memcmp(
+             elem->values, control->values, control->n_values * sizeof(long)
+           );
+
+  return get_cached_elem_value(elem) == control->values[0];
+}
+
+// Set an element to a control's value
+static void set_elem_from_control(struct native_control *control) {
+  struct alsa_elem *elem = control->elem;
+
   // bytes type for custom names
-  if (type == SND_CTL_ELEM_TYPE_BYTES) {
-    size_t len = strlen(str);
-    alsa_set_elem_bytes(elem, str, len);
+  if (!control->values) {
+    alsa_set_elem_bytes(elem, control->value, strlen(control->value));
     // alsa_set_elem_bytes already schedules callback for simulated elements
     return;
   }
 
-  // single value
-  long value;
-  if (string_to_elem_value(elem, str, &value) == 0) {
-    alsa_set_elem_value(elem, value);
-    // explicitly trigger callback to update UI immediately
-    alsa_elem_change(elem);
+  if (elem->type == SND_CTL_ELEM_TYPE_INTEGER && elem->count > 1)
+    alsa_set_elem_int_values(elem, control->values, control->n_values);
+  else
+    alsa_set_elem_value(elem, control->values[0]);
+
+  // explicitly trigger callback to update the UI (at the end of the
+  // load's change batch)
+  alsa_elem_change(elem);
+}
+
+// Binary snapshots
+//
+// A keyfile can have a binary snapshot next to it ("name.snap" for
+// "name.conf") holding the same controls with their values already
+// parsed: a header, the control table, the integer values, and a
+// string table with the model, the control names, and the bytes
+// values. The file is mapped and its names and values used in place.
+// Enum values are stored as indexes, so a snapshot is only used if
+// it was saved from the same model and firmware version. It's only
+// written once its keyfile has been, and records the keyfile's
+// device, inode, size, and modification time; if the keyfile doesn't
+// match exactly (it was replaced, edited, or restored with its old
+// timestamp), the keyfile is read.
+
+#define NATIVE_SNAPSHOT_MAGIC      "ASGSNAP"
+#define NATIVE_SNAPSHOT_VERSION    2
+#define NATIVE_SNAPSHOT_BYTE_ORDER 0x01020304
+
+struct native_snapshot_header {
+  char    magic[8];
+  guint32 version;
+  guint32 byte_order;
+  guint32 header_size;
+
+  // the keyfile that the snapshot was written after
+  guint32 keyfile_mtime_nsec;
+  guint64 keyfile_dev;
+  guint64 keyfile_inode;
+  guint64 keyfile_size;
+  gint64  keyfile_mtime_sec;
+
+  guint32 pid;
+  guint32 firmware_version[4];
+
+  // string table offset
+  guint32 model;
+
+  // struct native_snapshot_control[control_count]
+  guint32 controls_offset;
+  guint32 control_count;
+
+  // gint64[value_count], 8-byte aligned
+  guint32 values_offset;
+  guint32 value_count;
+
+  // NUL-terminated strings
+  guint32 strings_offset;
+  guint32 strings_size;
+};
+
+struct native_snapshot_control {
+  guint32 name;    // string table offset
+  guint32 type;    // SND_CTL_ELEM_TYPE_*
+  guint32 count;   // number of values; string length for bytes
+  guint32 offset;  // first value; string table offset for bytes
+};
+
+void native_snapshot_id_init(
+  struct alsa_card          *card,
+  struct native_snapshot_id *id
+) {
+  memset(id, 0, sizeof(*id));
+  id->pid = card->pid;
+  id->model = g_strdup(card->name ? card->name : "");
+
+  // FCP devices have a 4-valued version, the others a single value
+  if (card->driver_type == DRIVER_TYPE_SOCKET) {
+    for (int i = 0; i < 4; i++)
+      id->firmware_version[i] = card->firmware_version_4[i];
+  } else {
+    struct alsa_elem *elem = get_elem_by_name(card->elems, "Firmware Version");
+
+    if (elem)
+      id->firmware_version[0] = get_cached_elem_value(elem);
   }
 }
 
-// Load card configuration from native format
-int load_native(struct alsa_card *card, const char *path) {
+void native_snapshot_id_clear(struct native_snapshot_id *id) {
+  g_free(id->model);
+  id->model = NULL;
+}
+
+char *native_snapshot_path(const char *path) {
+  int len = strlen(path);
+
+  if (g_str_has_suffix(path, ".conf"))
+    len -= strlen(".conf");
+
+  return g_strdup_printf("%.*s.snap", len, path);
+}
+
+// Add a string to a snapshot string table; returns its offset
+static guint32 add_snapshot_string(
+  GString    *strings,
+  const char *str,
+  gsize       len
+) {
+  guint32 offset = strings->len;
+
+  g_string_append_len(strings, str, len);
+  g_string_append_c(strings, '\0');
+
+  return offset;
+}
+
+// Build the binary snapshot for the keyfile being saved to path; the
+// keyfile fields are filled in by write_native_snapshot()
+static char *build_native_snapshot(
+  struct alsa_card *card,
+  const char       *path,
+  gsize            *size
+) {
+  gint64 start_time = g_get_monotonic_time();
+  struct native_snapshot_id id;
+  struct native_snapshot_header header = {
+    .magic       = NATIVE_SNAPSHOT_MAGIC,
+    .version     = NATIVE_SNAPSHOT_VERSION,
+    .byte_order  = NATIVE_SNAPSHOT_BYTE_ORDER,
+    .header_size = sizeof(struct native_snapshot_header)
+  };
+  GArray *controls = g_array_new(
+    FALSE, FALSE, sizeof(struct native_snapshot_control)
+  );
+  GArray *values = g_array_new(FALSE, FALSE, sizeof(gint64));
+  GString *strings = g_string_new(NULL);
+
+  // control index + 1 by name; as in the keyfile, a later element
+  // with the same name replaces an earlier one
+  GHashTable *names = g_hash_table_new(g_str_hash, g_str_equal);
+
+  native_snapshot_id_init(card, &id);
+  header.pid = id.pid;
+  memcpy(
+    header.firmware_version, id.firmware_version,
+    sizeof(header.firmware_version)
+  );
+  header.model = add_snapshot_string(strings, id.model, strlen(id.model));
+  native_snapshot_id_clear(&id);
+
+  for (guint i = 0; i < card->elems->len; i++) {
+    struct alsa_elem *elem = g_ptr_array_index(card->elems, i);
+    struct native_snapshot_control control = { .type = elem->type };
+
+    if (!should_save_elem(elem))
+      continue;
+
+    if (elem->type == SND_CTL_ELEM_TYPE_BYTES) {
+      size_t size;
+      const char *data = alsa_get_elem_bytes(elem, &size);
+
+      control.count = data ? strnlen(data, size) : 0;
+      control.offset = add_snapshot_string(
+        strings, data ? data : "", control.count
+      );
+
+    } else if (elem->type == SND_CTL_ELEM_TYPE_INTEGER && elem->count > 1) {
+      control.count = elem->count;
+      control.offset = values->len;
+      for (int j = 0; j < elem->count; j++) {
+        gint64 value = elem->values ? elem->values[j] : 0;
+        g_array_append_val(values, value);
+      }
+
+    } else if (elem->type == SND_CTL_ELEM_TYPE_BOOLEAN ||
+               elem->type == SND_CTL_ELEM_TYPE_ENUMERATED ||
+               elem->type == SND_CTL_ELEM_TYPE_INTEGER) {
+      gint64 value = get_cached_elem_value(elem);
+
+      control.count = 1;
+      control.offset = values->len;
+      g_array_append_val(values, value);
+
+    } else {
+      continue;
+    }
+
+    int index = GPOINTER_TO_INT(g_hash_table_lookup(names, elem->name)) - 1;
+
+    if (index >= 0) {
+      control.name = g_array_index(
+        controls, struct native_snapshot_control, index
+      ).name;
+      g_array_index(controls, struct native_snapshot_control, index) =
+        control;
+      continue;
+    }
+
+    control.name = add_snapshot_string(
+      strings, elem->name, strlen(elem->name)
+    );
+    g_array_append_val(controls, control);
+    g_hash_table_insert(
+      names, elem->name, GINT_TO_POINTER(controls->len)
+    );
+  }
+
+  header.controls_offset = sizeof(header);
+  header.control_count = controls->len;
+  header.values_offset = (
+    header.controls_offset +
+      controls->len * sizeof(struct native_snapshot_control) + 7
+  ) & ~7;
+  header.value_count = values->len;
+  header.strings_offset =
+    header.values_offset + values->len * sizeof(gint64);
+  header.strings_size = strings->len;
+
+  *size = header.strings_offset + header.strings_size;
+  char *data = g_malloc0(*size);
+
+  memcpy(data, &header, sizeof(header));
+  memcpy(
+    data + header.controls_offset, controls->data,
+    controls->len * sizeof(struct native_snapshot_control)
+  );
+  memcpy(
+    data + header.values_offset, values->data,
+    values->len * sizeof(gint64)
+  );
+  memcpy(data + header.strings_offset, strings->str, strings->len);
+
+  if (debug_enabled("save"))
+    printf(
+      "SAVE: %s snapshot: %u controls, %zu bytes in %.1f ms\n",
+      path, controls->len, *size,
+      (g_get_monotonic_time() - start_time) / 1000.0
+    );
+
+  g_hash_table_destroy(names);
+  g_string_free(strings, TRUE);
+  g_array_free(values, TRUE);
+  g_array_free(controls, TRUE);
+
+  return data;
+}
+
+// Check that a snapshot was written after the keyfile with status st
+static int snapshot_keyfile_matches(
+  const struct native_snapshot_header *header,
+  const struct stat                   *st
+) {
+  return header->keyfile_dev == (guint64)st->st_dev &&
+         header->keyfile_inode == (guint64)st->st_ino &&
+         header->keyfile_size == (guint64)st->st_size &&
+         header->keyfile_mtime_sec == (gint64)st->st_mtim.tv_sec &&
+         header->keyfile_mtime_nsec == (guint32)st->st_mtim.tv_nsec;
+}
+
+// Write a snapshot from build_native_snapshot() for the keyfile at
+// path, which has just been written
+// The writer runs one operation at a time, so the keyfile is as the
+// save left it until this returns; a later save of the keyfile
+// replaces it (new inode) before this snapshot is written, so this
+// one won't match and the later one replaces it in turn
+static void write_native_snapshot(
+  const char *path,
+  char       *snapshot,
+  gsize       size
+) {
+  struct native_snapshot_header *header = (void *)snapshot;
+  struct stat st;
+
+  if (stat(path, &st) < 0)
+    return;
+
+  header->keyfile_dev = st.st_dev;
+  header->keyfile_inode = st.st_ino;
+  header->keyfile_size = st.st_size;
+  header->keyfile_mtime_sec = st.st_mtim.tv_sec;
+  header->keyfile_mtime_nsec = st.st_mtim.tv_nsec;
+
+  char *snapshot_path = native_snapshot_path(path);
+  state_writer_write(snapshot_path, snapshot, size, NULL, NULL);
+  g_free(snapshot_path);
+}
+
+// Check that a mapped snapshot's tables and strings are within it
+static int native_snapshot_valid(const char *base, gsize size) {
+  const struct native_snapshot_header *header = (const void *)base;
+
+  if (size < sizeof(*header) ||
+      memcmp(header->magic, NATIVE_SNAPSHOT_MAGIC, sizeof(header->magic)) ||
+      header->version != NATIVE_SNAPSHOT_VERSION ||
+      header->byte_order != NATIVE_SNAPSHOT_BYTE_ORDER ||
+      header->header_size != sizeof(*header))
+    return 0;
+
+  // (64-bit sums so that they can't wrap)
+  if (header->controls_offset % 4 ||
+      (guint64)header->controls_offset +
+        (guint64)header->control_count *
+          sizeof(struct native_snapshot_control) > size ||
+      header->values_offset % 8 ||
+      (guint64)header->values_offset +
+        (guint64)header->value_count * sizeof(gint64) > size ||
+      !header->strings_size ||
+      (guint64)header->strings_offset + header->strings_size > size)
+    return 0;
+
+  // the last string is terminated, so all of them are
+  const char *strings = base + header->strings_offset;
+
+  if (strings[header->strings_size - 1] ||
+      header->model >= header->strings_size)
+    return 0;
+
+  const struct native_snapshot_control *controls =
+    (const void *)(base + header->controls_offset);
+
+  for (guint32 i = 0; i < header->control_count; i++) {
+    const struct native_snapshot_control *control = &controls[i];
+
+    if (control->name >= header->strings_size)
+      return 0;
+
+    if (control->type == SND_CTL_ELEM_TYPE_BYTES) {
+      if ((guint64)control->offset + control->count >= header->strings_size)
+        return 0;
+    } else if (!control->count ||
+               (guint64)control->offset + control->count >
+                 header->value_count) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+// Map the snapshot of the keyfile at path if it can be used for the
+// device; returns NULL to read the keyfile instead
+static struct native_config *native_snapshot_read(
+  const char                      *path,
+  const struct native_snapshot_id *id
+) {
+  gint64 start_time = g_get_monotonic_time();
+  char *snapshot_path = native_snapshot_path(path);
+  struct native_config *config = NULL;
+  GMappedFile *mapped = NULL;
+  const char *reason = NULL;
+  struct stat conf_st;
+
+  // no snapshot
+  if (!g_file_test(snapshot_path, G_FILE_TEST_EXISTS) ||
+      stat(path, &conf_st) < 0)
+    goto done;
+
+  mapped = g_mapped_file_new(snapshot_path, FALSE, NULL);
+  if (!mapped) {
+    reason = "can't be mapped";
+    goto done;
+  }
+
+  const char *base = g_mapped_file_get_contents(mapped);
+  gsize size = g_mapped_file_get_length(mapped);
+
+  if (!base || !native_snapshot_valid(base, size)) {
+    reason = "is invalid";
+    goto done;
+  }
+
+  const struct native_snapshot_header *header = (const void *)base;
+  const char *strings = base + header->strings_offset;
+
+  // the keyfile has been replaced or changed since
+  if (!snapshot_keyfile_matches(header, &conf_st)) {
+    reason = "doesn't match the keyfile";
+    goto done;
+  }
+
+  if (header->pid != id->pid ||
+      memcmp(
+        header->firmware_version, id->firmware_version,
+        sizeof(header->firmware_version)
+      ) ||
+      strcmp(strings + header->model, id->model)) {
+    reason = "is from a different model or firmware version";
+    goto done;
+  }
+
+  config = g_malloc0(sizeof(struct native_config));
+  config->snapshot = mapped;
+  config->count = header->control_count;
+  config->controls = g_malloc0(
+    (config->count ? config->count : 1) * sizeof(struct native_control)
+  );
+
+  const gint64 *snapshot_values =
+    (const gint64 *)(base + header->values_offset);
+
+#if GLIB_SIZEOF_LONG == 8
+  long *values = (long *)snapshot_values;
+#else
+  long *values = g_malloc(
+    (header->value_count ? header->value_count : 1) * sizeof(long)
+  );
+
+  for (guint32 i = 0; i < header->value_count; i++)
+    values[i] = snapshot_values[i];
+  config->snapshot_values = values;
+#endif
+
+  const struct native_snapshot_control *controls =
+    (const void *)(base + header->controls_offset);
+
+  for (int i = 0; i < config->count; i++) {
+    struct native_control *control = &config->controls[i];
+
+    control->name = (char *)strings + controls[i].name;
+    control->type = controls[i].type;
+
+    if (control->type == SND_CTL_ELEM_TYPE_BYTES) {
+      control->value = (char *)strings + controls[i].offset;
+    } else {
+      control->values = values + controls[i].offset;
+      control->n_values = controls[i].count;
+    }
+  }
+
+  if (debug_enabled("load"))
+    printf(
+      "LOAD: %s: %d controls mapped in %.1f ms\n",
+      snapshot_path, config->count,
+      (g_get_monotonic_time() - start_time) / 1000.0
+    );
+
+done:
+  if (reason && debug_enabled("load"))
+    printf("LOAD: %s %s; reading the keyfile\n", snapshot_path, reason);
+
+  if (mapped && !config)
+    g_mapped_file_unref(mapped);
+  g_free(snapshot_path);
+
+  return config;
+}
+
+// Check that a snapshot control's values fit its element
+static int snapshot_control_fits(struct native_control *control) {
+  struct alsa_elem *elem = control->elem;
+
+  if (elem->type != control->type)
+    return 0;
+
+  if (elem->type == SND_CTL_ELEM_TYPE_BYTES)
+    return 1;
+
+  if (elem->type == SND_CTL_ELEM_TYPE_INTEGER && elem->count > 1)
+    return control->n_values <= elem->count;
+
+  return control->n_values == 1;
+}
+
+// Read the controls of a native configuration file, from its
+// snapshot if there's one usable for the device id (if not NULL)
+// Doesn't touch the card, so can be called from any thread
+struct native_config *native_config_read(
+  const char                      *path,
+  const struct native_snapshot_id *id
+) {
+  if (id) {
+    struct native_config *config = native_snapshot_read(path, id);
+
+    if (config)
+      return config;
+  }
+
+  gint64 start_time = g_get_monotonic_time();
   GKeyFile *key_file = g_key_file_new();
-  GError *error = NULL;
 
-  if (!g_key_file_load_from_file(key_file, path, G_KEY_FILE_NONE, &error)) {
+  if (!g_key_file_load_from_file(key_file, path, G_KEY_FILE_NONE, NULL)) {
     g_key_file_free(key_file);
-    if (error)
-      g_error_free(error);
-    return -1;
+    return NULL;
   }
 
+  struct native_config *config = g_malloc0(sizeof(struct native_config));
+
   // get all keys from controls section
   gsize num_keys;
   gchar **keys = g_key_file_get_keys(
     key_file, CONFIG_SECTION_CONTROLS, &num_keys, NULL
   );
 
-  if (!keys) {
-    g_key_file_free(key_file);
-    return 0;
-  }
+  if (keys) {
+    config->controls = g_malloc0(num_keys * sizeof(struct native_control));
 
-  // two passes: some elements may be read-only until other controls
-  // (like enable switches) are set first
-  for (int pass = 0; pass < 2; pass++) {
-
-    // for each key, find the matching element and set its value
     for (gsize i = 0; i < num_keys; i++) {
       gchar *value = g_key_file_get_string(
         key_file, CONFIG_SECTION_CONTROLS, keys[i], NULL
       );
 
-      if (!value)
+      if (!value) {
+        config->unknown++;
+        g_free(keys[i]);
         continue;
+      }
+
+      config->controls[config->count].name = keys[i];
+      config->controls[config->count].value = value;
+      config->count++;
+    }
+
+    // the strings are owned by the controls now
+    g_free(keys);
+  }
+
+  if (debug_enabled("load"))
+    printf(
+      "LOAD: %s: %d controls read in %.1f ms\n",
+      path, config->count, (g_get_monotonic_time() - start_time) / 1000.0
+    );
+
+  g_key_file_free(key_file);
+
+  return config;
+}
+
+// Find the card's element of each control and parse its value (or
+// check that the snapshot's value fits it)
+void native_config_resolve(
+  struct alsa_card     *card,
+  struct native_config *config
+) {
+  gint64 start_time = g_get_monotonic_time();
+
+  // index the elements by name; the first element of a name wins,
+  // as with get_elem_by_name()
+  GHashTable *elems_by_name = g_hash_table_new(g_str_hash, g_str_equal);
+
+  for (int i = 0; i < card->elems->len; i++) {
+    struct alsa_elem *elem = g_ptr_array_index(card->elems, i);
+
+    if (elem->card && !g_hash_table_contains(elems_by_name, elem->name))
+      g_hash_table_insert(elems_by_name, elem->name, elem);
+  }
+
+  int count = 0;
+
+  for (int i = 0; i < config->count; i++) {
+    struct native_control control = config->controls[i];
+
+    control.elem = g_hash_table_lookup(elems_by_name, control.name);
+    if (!config->snapshot)
+      g_free(control.name);
+    control.name = NULL;
 
-      // find element by name
-      struct alsa_elem *elem = get_elem_by_name(card->elems, keys[i]);
-      if (!elem) {
-        g_free(value);
+    int usable = control.elem && (
+      config->snapshot
+        ? snapshot_control_fits(&control)
+        : parse_control_value(&control) == 0
+    );
+
+    if (!usable) {
+      if (!config->snapshot)
+        g_free(control.value);
+      config->unknown++;
+      continue;
+    }
+
+    config->controls[count++] = control;
+  }
+
+  config->count = count;
+
+  if (debug_enabled("load"))
+    printf(
+      "LOAD: %d controls, %d unknown; resolved in %.1f ms\n",
+      config->count, config->unknown,
+      (g_get_monotonic_time() - start_time) / 1000.0
+    );
+
+  g_hash_table_destroy(elems_by_name);
+}
+
+// Parse a native configuration file into a table of the card's
+// elements and their values
+struct native_config *native_config_parse(
+  struct alsa_card *card,
+  const char       *path
+) {
+  struct native_snapshot_id id;
+
+  native_snapshot_id_init(card, &id);
+  struct native_config *config = native_config_read(path, &id);
+  native_snapshot_id_clear(&id);
+
+  if (config)
+    native_config_resolve(card, config);
+
+  return config;
+}
+
+void native_config_free(struct native_config *config) {
+  if (!config)
+    return;
+
+  // a snapshot's names and values are in the mapping
+  if (config->snapshot) {
+    g_mapped_file_unref(config->snapshot);
+  } else {
+    for (int i = 0; i < config->count; i++) {
+      g_free(config->controls[i].name);
+      g_free(config->controls[i].value);
+      g_free(config->controls[i].values);
+    }
+  }
+  g_free(config->snapshot_values);
+  g_free(config->controls);
+  g_free(config);
+}
+
+// Apply a parsed configuration to the card
+// Each control is compared with the cached element value and only
+// the ones that differ are set, in one pass in load rank order;
+// writability is checked when each control's turn comes, after the
+// controls which usually unlock it, and the ones still read-only are
+// retried once at the end in case some other control unlocked them.
+// Element callbacks are batched until the end.
+void native_config_apply(
+  struct alsa_card         *card,
+  struct native_config     *config,
+  struct load_native_stats *stats
+) {
+  gint64 start_time = g_get_monotonic_time();
+  int count = config->count;
+
+  // diff against the current values; changed[i] is the load rank + 1
+  // of each control that needs setting, 0 if unchanged
+  char *changed = g_malloc0(count ? count : 1);
+  int unchanged = 0;
+
+  for (int i = 0; i < count; i++) {
+    struct native_control *control = &config->controls[i];
+
+    if (control_is_current(control))
+      unchanged++;
+    else
+      changed[i] = get_load_rank(control->elem) + 1;
+  }
+
+  gint64 diff_time = g_get_monotonic_time();
+
+  // defer the callbacks and routing UI updates to the end
+  alsa_elem_change_batch_begin(card);
+  card->routing_ui_update_deferred = TRUE;
+
+  int written = 0;
+  int read_only = 0;
+
+  // controls which were read-only at their turn, in rank order
+  int *locked = g_malloc((count ? count : 1) * sizeof(int));
+  int locked_count = 0;
+
+  for (int rank = 0; rank < LOAD_RANK_COUNT; rank++) {
+    for (int i = 0; i < count; i++) {
+      struct native_control *control = &config->controls[i];
+
+      if (changed[i] != rank + 1)
         continue;
-      }
 
-      // skip non-writable elements (may become writable on second pass)
-      if (!alsa_get_elem_writable(elem)) {
-        g_free(value);
+      if (!alsa_get_elem_writable(control->elem)) {
+        locked[locked_count++] = i;
         continue;
       }
 
-      // convert string to value and set
-      set_elem_from_string(elem, value);
+      set_elem_from_control(control);
+      written++;
+    }
+  }
 
-      g_free(value);
+  // the ranks are only a guess at which controls unlock others, so
+  // retry the locked ones once now that everything else is set
+  for (int j = 0; j < locked_count; j++) {
+    struct native_control *control = &config->controls[locked[j]];
+
+    if (!alsa_get_elem_writable(control->elem)) {
+      read_only++;
+      continue;
     }
+
+    set_elem_from_control(control);
+    written++;
   }
 
-  g_strfreev(keys);
-  g_key_file_free(key_file);
+  g_free(locked);
+
+  gint64 write_time = g_get_monotonic_time();
+
+  alsa_elem_change_batch_end(card);
+  schedule_ui_update(card, PENDING_UI_UPDATE_ROUTING);
+
+  gint64 end_time = g_get_monotonic_time();
+
+  if (debug_enabled("load"))
+    printf(
+      "LOAD: %d compared, %d changed, %d unchanged, %d read-only; "
+        "diff %.1f ms, write %.1f ms, callbacks %.1f ms\n",
+      count, written, unchanged, read_only,
+      (diff_time - start_time) / 1000.0,
+      (write_time - diff_time) / 1000.0,
+      (end_time - write_time) / 1000.0
+    );
+
+  if (stats) {
+    stats->compared = count;
+    stats->changed = written;
+    stats->skipped = unchanged + read_only;
+    stats->elapsed_ms = (end_time - start_time) / 1000.0;
+  }
+
+  g_free(changed);
+}
+
+// Load card configuration from native format
+int load_native(
+  struct alsa_card         *card,
+  const char               *path,
+  struct load_native_stats *stats
+) {
+  gint64 start_time = g_get_monotonic_time();
+  struct native_config *config = native_config_parse(card, path);
+
+  if (!config)
+    return -1;
+
+  native_config_apply(card, config, stats);
+  native_config_free(config);
+
+  // include the parsing time
+  if (stats)
+    stats->elapsed_ms = (g_get_monotonic_time() - start_time) / 1000.0;
 
   return 0;
 }
@@ -408,7 +1280,7 @@ static void load_dialog_complete(
 
   // determine format from extension
   if (string_ends_with(fn, ".conf")) {
-    if (load_native(card, fn) < 0) {
+    if (load_native(card, fn, NULL) < 0) {
       char *msg = g_strdup_printf("Error loading from %s", fn);
       show_error(w, msg);
       g_free(msg);
@@ -481,15 +1353,10 @@ static void save_dialog_complete(
     fn_with_ext = g_strdup(fn);
   }
 
-  if (use_native) {
-    if (save_native(card, fn_with_ext) < 0) {
-      char *msg = g_strdup_printf("Error saving to %s", fn_with_ext);
-      show_error(w, msg);
-      g_free(msg);
-    }
-  } else {
+  if (use_native)
+    save_native(card, fn_with_ext);
+  else
     run_alsactl(card, "store", fn_with_ext);
-  }
 
   g_free(fn);
   g_free(fn_with_ext);
@@ -593,7 +1460,7 @@ static void load_response(
 
   // determine format from extension
   if (string_ends_with(fn, ".conf")) {
-    if (load_native(card, fn) < 0) {
+    if (load_native(card, fn, NULL) < 0) {
       char *msg = g_strdup_printf("Error loading from %s", fn);
       show_error(w, msg);
       g_free(msg);
@@ -636,7 +1503,6 @@ static void save_response(
   gpointer         data
 ) {
   struct alsa_card *card = data;
-  GtkWindow *w = GTK_WINDOW(card->window_main);
 
   if (response != GTK_RESPONSE_ACCEPT)
     goto done;
@@ -657,15 +1523,10 @@ static void save_response(
     fn_with_ext = g_strdup(fn);
   }
 
-  if (use_native) {
-    if (save_native(card, fn_with_ext) < 0) {
-      char *msg = g_strdup_printf("Error saving to %s", fn_with_ext);
-      show_error(w, msg);
-      g_free(msg);
-    }
-  } else {
+  if (use_native)
+    save_native(card, fn_with_ext);
+  else
     run_alsactl(card, "store", fn_with_ext);
-  }
 
   g_free(fn);
   g_free(fn_with_ext);
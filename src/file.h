@@ -7,9 +7,75 @@
 
 #include "alsa.h"
 
+// statistics of applying a native configuration
+struct load_native_stats {
+  int    compared;    // controls in the file which the card has
+  int    changed;     // controls set
+  int    skipped;     // controls unchanged or read-only
+  double elapsed_ms;
+};
+
 // load/save configuration in native format (used by file dialogs and presets)
-int load_native(struct alsa_card *card, const char *path);
-int save_native(struct alsa_card *card, const char *path);
+// load_native() only sets the controls which differ; stats may be
+// NULL
+int load_native(
+  struct alsa_card         *card,
+  const char               *path,
+  struct load_native_stats *stats
+);
+void save_native(struct alsa_card *card, const char *path);
+
+// save_native() and, once the keyfile has been written, its binary
+// snapshot
+void save_native_with_snapshot(struct alsa_card *card, const char *path);
+
+// a native configuration parsed into the card's elements and values
+struct native_config;
+
+// parse a native configuration file; returns NULL if it can't be read
+struct native_config *native_config_parse(
+  struct alsa_card *card,
+  const char       *path
+);
+
+// the device a binary snapshot was saved from; snapshots store enum
+// values as indexes so are only used for the same model and firmware
+struct native_snapshot_id {
+  guint32  pid;
+  guint32  firmware_version[4];
+  char    *model;
+};
+
+void native_snapshot_id_init(
+  struct alsa_card          *card,
+  struct native_snapshot_id *id
+);
+void native_snapshot_id_clear(struct native_snapshot_id *id);
+
+// the snapshot path for a keyfile path (.conf replaced with .snap)
+char *native_snapshot_path(const char *path);
+
+// native_config_parse() in two steps: native_config_read() only
+// reads the file (or its snapshot, if there is one for id) so can run
+// on a worker thread, and native_config_resolve() (on the main
+// thread) finds the card's elements and parses the values for them
+struct native_config *native_config_read(
+  const char                      *path,
+  const struct native_snapshot_id *id
+);
+void native_config_resolve(
+  struct alsa_card     *card,
+  struct native_config *config
+);
+
+// set the controls which differ from the configuration
+void native_config_apply(
+  struct alsa_card         *card,
+  struct native_config     *config,
+  struct load_native_stats *stats
+);
+
+void native_config_free(struct native_config *config);
 
 // load/save configuration (supports both alsactl .state and native .conf)
 void activate_load(GSimpleAction *action, GVariant *parameter, gpointer data);
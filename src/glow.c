@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "glow.h"
+#include "routing-graph.h"
 
 // calculate glow intensity (0 to 1) from dB level, with curve applied
 double get_glow_intensity(double level_db) {
@@ -19,6 +20,11 @@ double get_glow_intensity(double level_db) {
   return intensity * intensity;
 }
 
+// quantise a dB level to a glow intensity step (0 to GLOW_BUCKETS)
+int get_glow_bucket(double level_db) {
+  return get_glow_intensity(level_db) * GLOW_BUCKETS;
+}
+
 // calculate glow layer width and alpha for a given layer and intensity
 void get_glow_layer_params(
   int     layer,
@@ -146,17 +152,11 @@ static int compute_src_level_index(
 
   // without labels, level meters are at sinks only; find a sink
   // connected to this source and return its level index
-  for (int i = 0; i < card->routing_snks->len; i++) {
-    struct routing_snk *r_snk = &g_array_index(
-      card->routing_snks, struct routing_snk, i
-    );
-
-    if (r_snk->effective_source_idx != r_src->id)
-      continue;
-
+  for (struct routing_snk *r_snk = routing_graph_first_snk(card, r_src);
+       r_snk;
+       r_snk = routing_graph_next_snk(card, r_snk))
     if (r_snk->level_index >= 0)
       return r_snk->level_index;
-  }
 
   return -1;
 }
@@ -12,9 +12,16 @@
 #define GLOW_MIN_DB -60.0
 #define GLOW_MAX_DB 0.0
 
+// number of distinct glow intensity steps; a glow only needs to be
+// redrawn when its level moves to a different step
+#define GLOW_BUCKETS 32
+
 // calculate glow intensity (0 to 1) from dB level, with curve applied
 double get_glow_intensity(double level_db);
 
+// quantise a dB level to a glow intensity step (0 to GLOW_BUCKETS)
+int get_glow_bucket(double level_db);
+
 // calculate glow layer width and alpha for a given layer and intensity
 void get_glow_layer_params(
   int     layer,
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <math.h>
+#include <string.h>
+
+#include "hit-grid.h"
+
+// limit on cells per axis so a few huge or far-apart rectangles
+// don't make the grid arbitrarily large
+#define HIT_GRID_MAX_CELLS 256
+
+void hit_grid_init(struct hit_grid *grid) {
+  memset(grid, 0, sizeof(*grid));
+}
+
+void hit_grid_free(struct hit_grid *grid) {
+  g_free(grid->rects);
+  g_free(grid->cell_start);
+  g_free(grid->cell_items);
+  hit_grid_init(grid);
+}
+
+void hit_grid_clear(struct hit_grid *grid) {
+  grid->count = 0;
+  grid->cols = 0;
+  grid->rows = 0;
+}
+
+void hit_grid_add(
+  struct hit_grid *grid,
+  float            x,
+  float            y,
+  float            w,
+  float            h,
+  void            *data
+) {
+  if (grid->count == grid->alloc) {
+    grid->alloc = grid->alloc ? grid->alloc * 2 : 32;
+    grid->rects = g_realloc(
+      grid->rects, grid->alloc * sizeof(struct hit_rect)
+    );
+  }
+
+  struct hit_rect *rect = &grid->rects[grid->count++];
+
+  rect->x = x;
+  rect->y = y;
+  rect->w = w;
+  rect->h = h;
+  rect->data = data;
+}
+
+static int cell_col(struct hit_grid *grid, float x) {
+  return floorf((x - grid->x0) / grid->cell_w);
+}
+
+static int cell_row(struct hit_grid *grid, float y) {
+  return floorf((y - grid->y0) / grid->cell_h);
+}
+
+void hit_grid_build(struct hit_grid *grid) {
+  grid->cols = 0;
+  grid->rows = 0;
+
+  if (!grid->count)
+    return;
+
+  float x0 = INFINITY, y0 = INFINITY, x1 = -INFINITY, y1 = -INFINITY;
+  float total_w = 0, total_h = 0;
+
+  for (int i = 0; i < grid->count; i++) {
+    struct hit_rect *rect = &grid->rects[i];
+
+    x0 = MIN(x0, rect->x);
+    y0 = MIN(y0, rect->y);
+    x1 = MAX(x1, rect->x + rect->w);
+    y1 = MAX(y1, rect->y + rect->h);
+    total_w += rect->w;
+    total_h += rect->h;
+  }
+
+  // cells about the size of an average rectangle
+  grid->x0 = x0;
+  grid->y0 = y0;
+  grid->cell_w = MAX(MAX(total_w / grid->count, 1),
+                     (x1 - x0) / HIT_GRID_MAX_CELLS);
+  grid->cell_h = MAX(MAX(total_h / grid->count, 1),
+                     (y1 - y0) / HIT_GRID_MAX_CELLS);
+  grid->cols = cell_col(grid, x1) + 1;
+  grid->rows = cell_row(grid, y1) + 1;
+
+  int cell_count = grid->cols * grid->rows;
+
+  g_free(grid->cell_start);
+  grid->cell_start = g_malloc0((cell_count + 1) * sizeof(int));
+
+  // count the rectangles overlapping each cell
+  for (int i = 0; i < grid->count; i++) {
+    struct hit_rect *rect = &grid->rects[i];
+    int c0 = cell_col(grid, rect->x), c1 = cell_col(grid, rect->x + rect->w);
+    int r0 = cell_row(grid, rect->y), r1 = cell_row(grid, rect->y + rect->h);
+
+    for (int r = r0; r <= r1; r++)
+      for (int c = c0; c <= c1; c++)
+        grid->cell_start[r * grid->cols + c + 1]++;
+  }
+
+  for (int i = 0; i < cell_count; i++)
+    grid->cell_start[i + 1] += grid->cell_start[i];
+
+  // fill the cells in insertion order
+  int *fill = g_malloc(cell_count * sizeof(int));
+  memcpy(fill, grid->cell_start, cell_count * sizeof(int));
+
+  g_free(grid->cell_items);
+  grid->cell_items = g_malloc(
+    MAX(grid->cell_start[cell_count], 1) * sizeof(int)
+  );
+
+  for (int i = 0; i < grid->count; i++) {
+    struct hit_rect *rect = &grid->rects[i];
+    int c0 = cell_col(grid, rect->x), c1 = cell_col(grid, rect->x + rect->w);
+    int r0 = cell_row(grid, rect->y), r1 = cell_row(grid, rect->y + rect->h);
+
+    for (int r = r0; r <= r1; r++)
+      for (int c = c0; c <= c1; c++)
+        grid->cell_items[fill[r * grid->cols + c]++] = i;
+  }
+
+  g_free(fill);
+}
+
+void *hit_grid_lookup(struct hit_grid *grid, float x, float y) {
+  if (!grid->cols)
+    return NULL;
+
+  int c = cell_col(grid, x);
+  int r = cell_row(grid, y);
+
+  if (c < 0 || c >= grid->cols || r < 0 || r >= grid->rows)
+    return NULL;
+
+  int cell = r * grid->cols + c;
+
+  for (int i = grid->cell_start[cell]; i < grid->cell_start[cell + 1]; i++) {
+    struct hit_rect *rect = &grid->rects[grid->cell_items[i]];
+
+    if (x >= rect->x && x <= rect->x + rect->w &&
+        y >= rect->y && y <= rect->y + rect->h)
+      return rect->data;
+  }
+
+  return NULL;
+}
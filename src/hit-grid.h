@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <glib.h>
+
+// Uniform grid spatial index over a set of rectangles for point hit
+// testing. Rectangles are added, then hit_grid_build() buckets them
+// into cells about the size of an average rectangle, so a lookup
+// only tests the few rectangles overlapping the point's cell.
+
+struct hit_rect {
+  float  x, y, w, h;
+  void  *data;
+};
+
+struct hit_grid {
+  struct hit_rect *rects;
+  int              count;
+  int              alloc;
+
+  // cell geometry, set by hit_grid_build()
+  float            x0, y0;
+  float            cell_w, cell_h;
+  int              cols, rows;
+
+  // rects overlapping cell c are cell_items[cell_start[c] ..
+  // cell_start[c + 1] - 1], in the order they were added
+  int             *cell_start;
+  int             *cell_items;
+};
+
+void hit_grid_init(struct hit_grid *grid);
+void hit_grid_free(struct hit_grid *grid);
+
+// remove all rectangles
+void hit_grid_clear(struct hit_grid *grid);
+
+// add a rectangle; call hit_grid_build() before looking up
+void hit_grid_add(
+  struct hit_grid *grid,
+  float            x,
+  float            y,
+  float            w,
+  float            h,
+  void            *data
+);
+
+void hit_grid_build(struct hit_grid *grid);
+
+// return the data of the first added rectangle containing the point
+// (edges inclusive, like graphene_rect_contains_point()), or NULL
+void *hit_grid_lookup(struct hit_grid *grid, float x, float y);
@@ -1,11 +1,11 @@
 // SPDX-FileCopyrightText: 2022-2025 Geoffrey D. Bennett <g@b4.vu>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include "config-io.h"
 #include "glow.h"
 #include "gtkhelper.h"
 #include "iface-mixer.h"
 #include "presets.h"
-#include "window-preferences.h"
 #include "routing-lines.h"
 #include "stringhelper.h"
 #include "tooltips.h"
@@ -16,13 +16,11 @@
 #include "widget-input-select.h"
 #include "widget-label.h"
 #include "widget-sample-rate.h"
-#include "window-configuration.h"
 #include "window-dsp.h"
 #include "window-helper.h"
 #include "window-levels.h"
 #include "window-mixer.h"
 #include "window-routing.h"
-#include "window-startup.h"
 
 // find the routing sink for a hardware output by port number
 static struct routing_snk *get_output_r_snk(
@@ -1434,18 +1432,6 @@ static gboolean window_mixer_close_request(GtkWindow *w, gpointer data) {
   return true;
 }
 
-static gboolean window_configuration_close_request(GtkWindow *w, gpointer data) {
-  struct alsa_card *card = data;
-
-  gtk_widget_activate_action(
-    card->window_main,
-    "win.configuration",
-    NULL
-  );
-
-  return true;
-}
-
 static gboolean window_levels_close_request(GtkWindow *w, gpointer data) {
   struct alsa_card *card = data;
 
@@ -1464,15 +1450,6 @@ static gboolean window_dsp_close_request(GtkWindow *w, gpointer data) {
   return true;
 }
 
-static gboolean window_preferences_close_request(GtkWindow *w, gpointer data) {
-  struct alsa_card *card = data;
-
-  gtk_widget_activate_action(
-    GTK_WIDGET(card->window_main), "win.preferences", NULL
-  );
-  return true;
-}
-
 // wrap a scrolled window around the controls
 static void create_scrollable_window(GtkWidget *window, GtkWidget *controls) {
   GtkWidget *scrolled_window = gtk_scrolled_window_new();
@@ -1551,20 +1528,9 @@ GtkWidget *create_iface_mixer_main(struct alsa_card *card) {
 
   gtk_window_set_child(GTK_WINDOW(card->window_levels), levels_top);
 
-  card->window_startup = create_subwindow(
-    card, "Startup Configuration", G_CALLBACK(window_startup_close_request)
-  );
-
-  GtkWidget *startup = create_startup_controls(card);
-  gtk_window_set_child(GTK_WINDOW(card->window_startup), startup);
-
-  card->window_configuration = create_subwindow(
-    card, "Configuration", G_CALLBACK(window_configuration_close_request)
-  );
-  gtk_window_set_resizable(GTK_WINDOW(card->window_configuration), TRUE);
-
-  GtkWidget *configuration = create_configuration_controls(card);
-  gtk_window_set_child(GTK_WINDOW(card->window_configuration), configuration);
+  // the startup, configuration, and preferences windows are created
+  // by the menu actions when first shown
+  add_config_io_source_name_callbacks(card);
 
   // create DSP window if DSP controls are available
   if (get_elem_by_name(card->elems, "Line In 1 DSP Capture Switch")) {
@@ -1576,15 +1542,5 @@ GtkWidget *create_iface_mixer_main(struct alsa_card *card) {
     gtk_window_set_child(GTK_WINDOW(card->window_dsp), dsp);
   }
 
-  card->window_preferences = create_subwindow(
-    card, "Preferences",
-    G_CALLBACK(window_preferences_close_request)
-  );
-
-  GtkWidget *preferences = create_preferences_controls(card);
-  gtk_window_set_child(
-    GTK_WINDOW(card->window_preferences), preferences
-  );
-
   return top;
 }
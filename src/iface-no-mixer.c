@@ -7,8 +7,6 @@
 #include "tooltips.h"
 #include "widget-boolean.h"
 #include "widget-drop-down.h"
-#include "window-helper.h"
-#include "window-startup.h"
 
 GtkWidget *create_iface_no_mixer_main(struct alsa_card *card) {
   GPtrArray *elems = card->elems;
@@ -117,12 +115,8 @@ GtkWidget *create_iface_no_mixer_main(struct alsa_card *card) {
     }
   }
 
-  card->window_startup = create_subwindow(
-    card, "Startup Configuration", G_CALLBACK(window_startup_close_request)
-  );
-
-  GtkWidget *startup = create_startup_controls(card);
-  gtk_window_set_child(GTK_WINDOW(card->window_startup), startup);
+  // the startup window is created by the menu action when first
+  // shown
 
   return top;
 }
@@ -7,8 +7,10 @@
 #include "debug.h"
 #include "main.h"
 #include "menu.h"
+#include "optional-state.h"
 #include "scarlett2-firmware.h"
 #include "scarlett4-firmware.h"
+#include "state-writer.h"
 #include "window-hardware.h"
 #include "window-iface.h"
 
@@ -77,6 +79,12 @@ int main(int argc, char **argv) {
   g_signal_connect(app, "activate", G_CALLBACK(activate), NULL);
   g_signal_connect(app, "open", G_CALLBACK(open_cb), NULL);
   int status = g_application_run(G_APPLICATION(app), argc, argv);
+
+  // finish writing any saved state and presets, including state
+  // saves still waiting for the debounce
+  optional_state_flush();
+  state_writer_flush();
+
   g_object_unref(app);
 
   return status;
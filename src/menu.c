@@ -1,32 +1,63 @@
 // SPDX-FileCopyrightText: 2022-2025 Geoffrey D. Bennett <g@b4.vu>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <stdio.h>
+
 #include "about.h"
+#include "debug.h"
 #include "file.h"
 #include "menu.h"
 #include "optional-state.h"
+#include "snapshot-history.h"
 #include "window-hardware.h"
 #include "window-configuration.h"
+#include "window-preferences.h"
+#include "window-startup.h"
 
 // mapping of action names to window offsets within struct alsa_card
+// windows with a create function are not built until first shown
 struct window_action {
   const char *action_name;
   size_t      window_offset;
+  GtkWidget *(*create)(struct alsa_card *card);
 };
 
 static const struct window_action window_actions[] = {
   { "routing",       offsetof(struct alsa_card, window_routing)       },
   { "mixer",         offsetof(struct alsa_card, window_mixer)         },
   { "levels",        offsetof(struct alsa_card, window_levels)        },
-  { "configuration", offsetof(struct alsa_card, window_configuration) },
-  { "startup",       offsetof(struct alsa_card, window_startup)       },
+  { "configuration", offsetof(struct alsa_card, window_configuration),
+    create_configuration_window                                       },
+  { "startup",       offsetof(struct alsa_card, window_startup),
+    create_startup_window                                             },
   { "dsp",           offsetof(struct alsa_card, window_dsp)           },
-  { "preferences",   offsetof(struct alsa_card, window_preferences)   },
+  { "preferences",   offsetof(struct alsa_card, window_preferences),
+    create_preferences_window                                         },
   { NULL, 0 }
 };
 
-static GtkWidget *get_card_window(struct alsa_card *card, size_t offset) {
-  return *(GtkWidget **)((char *)card + offset);
+// get a card window, creating it if it hasn't been shown before
+static GtkWidget *get_card_window(
+  struct alsa_card           *card,
+  const struct window_action *entry
+) {
+  GtkWidget **window =
+    (GtkWidget **)((char *)card + entry->window_offset);
+
+  if (*window || !entry->create)
+    return *window;
+
+  gint64 start = g_get_monotonic_time();
+
+  *window = entry->create(card);
+
+  if (debug_enabled("window-timing"))
+    printf(
+      "WINDOW-TIMING: created %s window in %.1f ms\n",
+      entry->action_name, (g_get_monotonic_time() - start) / 1000.0
+    );
+
+  return *window;
 }
 
 static const struct window_action *find_window_action(const char *action_name) {
@@ -83,7 +114,10 @@ static void activate_window(
   if (!entry)
     return;
 
-  GtkWidget *window = get_card_window(card, entry->window_offset);
+  GtkWidget *window = get_card_window(card, entry);
+  if (!window)
+    return;
+
   gboolean new_state = toggle_visibility(action, window);
   save_window_state(card, action_name, new_state);
 }
@@ -132,6 +166,16 @@ static const struct menu_data menus[] = {
       {}
     }
   },
+  {
+    "_Edit",
+    (struct menu_item[]){
+      { "_Undo",         "win.undo",       { "<Control>Z",        NULL } },
+      { "_Redo",         "win.redo",       { "<Control><Shift>Z", NULL } },
+      { "_Mark A/B",     "win.ab-mark",    { "<Control><Shift>B", NULL } },
+      { "_Compare A/B",  "win.ab-compare", { "<Control>B",        NULL } },
+      {}
+    }
+  },
   {
     "_View",
     (struct menu_item[]){
@@ -231,6 +275,45 @@ static const GActionEntry mixer_entries[] = {
   {"mixer",   activate_window, NULL, "false"}
 };
 
+static void activate_undo(
+  GSimpleAction *action,
+  GVariant      *parameter,
+  gpointer       data
+) {
+  snapshot_history_undo(data);
+}
+
+static void activate_redo(
+  GSimpleAction *action,
+  GVariant      *parameter,
+  gpointer       data
+) {
+  snapshot_history_redo(data);
+}
+
+static void activate_ab_mark(
+  GSimpleAction *action,
+  GVariant      *parameter,
+  gpointer       data
+) {
+  snapshot_history_mark(data);
+}
+
+static void activate_ab_compare(
+  GSimpleAction *action,
+  GVariant      *parameter,
+  gpointer       data
+) {
+  snapshot_history_compare(data);
+}
+
+static const GActionEntry history_entries[] = {
+  {"undo",       activate_undo},
+  {"redo",       activate_redo},
+  {"ab-mark",    activate_ab_mark},
+  {"ab-compare", activate_ab_compare}
+};
+
 static const GActionEntry levels_entries[] = {
   {"levels", activate_window, NULL, "false"}
 };
@@ -247,6 +330,16 @@ void add_mixer_action_map(struct alsa_card *card) {
     card
   );
 
+  // Undo/redo of routing and mixer changes
+  if (card->snapshot_history) {
+    g_action_map_add_action_entries(
+      G_ACTION_MAP(card->window_main),
+      history_entries,
+      G_N_ELEMENTS(history_entries),
+      card
+    );
+  }
+
   // Hide the levels menu item if there is no level meter support
   if (card->has_levels) {
     g_action_map_add_action_entries(
@@ -310,11 +403,15 @@ static void restore_single_window(
   if (!should_restore_window(state, entry->action_name))
     return;
 
-  GtkWidget *window = get_card_window(card, entry->window_offset);
+  // the action is only present if the interface has this window
   GAction *action = g_action_map_lookup_action(
     G_ACTION_MAP(card->window_main), entry->action_name
   );
-  if (action)
+  if (!action)
+    return;
+
+  GtkWidget *window = get_card_window(card, entry);
+  if (window)
     set_window_visible(G_SIMPLE_ACTION(action), window, TRUE);
 }
 
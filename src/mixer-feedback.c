@@ -0,0 +1,343 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <stdio.h>
+
+#include "debug.h"
+#include "error.h"
+#include "mixer-feedback.h"
+
+struct mixer_feedback {
+
+  // the routing sink of each mixer input
+  struct routing_snk *inputs[MAX_MUX_IN];
+
+  // the mix feeding each mixer input (directly or through the DSP),
+  // or -1
+  int                 upstream[MAX_MUX_IN];
+
+  // whether each mixer cell has a non-zero gain
+  guint8              audible[MAX_MIX_OUT][MAX_MUX_IN];
+
+  // number of mixer inputs carrying mix u into mix v
+  int                 edges[MAX_MIX_OUT][MAX_MIX_OUT];
+
+  // bitmask of the mixes on a loop
+  int                 loop_mixes;
+
+  // idle to warn about a loop present at startup once the main
+  // window exists
+  guint               startup_warning_idle;
+};
+
+// encode a mixer cell as callback data (offset so it is never NULL)
+#define CELL_DATA(mix, input) \
+  GINT_TO_POINTER((mix) * MAX_MUX_IN + (input) + 1)
+
+// the mix number of a source, following DSP outputs back to the
+// source of the DSP input with the same number; -1 if not a mix
+static int get_upstream_mix(struct alsa_card *card, int src_idx) {
+  if (src_idx <= 0 || src_idx >= card->routing_srcs->len)
+    return -1;
+
+  struct routing_src *r_src = &g_array_index(
+    card->routing_srcs, struct routing_src, src_idx
+  );
+
+  if (r_src->port_category == PC_MIX)
+    return r_src->lr_num > 0 && r_src->lr_num <= MAX_MIX_OUT
+      ? r_src->lr_num - 1
+      : -1;
+
+  if (r_src->port_category != PC_DSP)
+    return -1;
+
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+    struct alsa_elem *elem = r_snk->elem;
+
+    if (elem->port_category != PC_DSP || elem->lr_num != r_src->lr_num)
+      continue;
+
+    int dsp_src_idx = alsa_get_elem_value(elem);
+    if (dsp_src_idx <= 0 || dsp_src_idx >= card->routing_srcs->len)
+      return -1;
+
+    struct routing_src *dsp_src = &g_array_index(
+      card->routing_srcs, struct routing_src, dsp_src_idx
+    );
+
+    if (dsp_src->port_category != PC_MIX ||
+        dsp_src->lr_num <= 0 || dsp_src->lr_num > MAX_MIX_OUT)
+      return -1;
+
+    return dsp_src->lr_num - 1;
+  }
+
+  return -1;
+}
+
+// bitmask of the mixes reachable from a mix
+static int get_reachable(struct mixer_feedback *fb, int from) {
+  int reached = 1 << from;
+  int queue[MAX_MIX_OUT];
+  int head = 0, tail = 0;
+
+  queue[tail++] = from;
+
+  while (head < tail) {
+    int u = queue[head++];
+
+    for (int v = 0; v < MAX_MIX_OUT; v++) {
+      if (!fb->edges[u][v] || (reached & (1 << v)))
+        continue;
+
+      reached |= 1 << v;
+      queue[tail++] = v;
+    }
+  }
+
+  return reached;
+}
+
+// bitmask of the mixes which can reach themselves
+static int find_loop_mixes(struct mixer_feedback *fb) {
+  int loop_mixes = 0;
+
+  for (int u = 0; u < MAX_MIX_OUT; u++)
+    for (int v = 0; v < MAX_MIX_OUT; v++)
+      if (fb->edges[u][v] && (get_reachable(fb, v) & (1 << u))) {
+        loop_mixes |= 1 << u;
+        break;
+      }
+
+  return loop_mixes;
+}
+
+static void warn_loop(struct alsa_card *card, int loop_mixes) {
+  GString *msg = g_string_new("Feedback loop detected through ");
+  int first = 1;
+
+  for (int m = 0; m < MAX_MIX_OUT; m++) {
+    if (!(loop_mixes & (1 << m)))
+      continue;
+
+    g_string_append_printf(msg, "%sMix %c", first ? "" : ", ", 'A' + m);
+    first = 0;
+  }
+  g_string_append(msg, " in the internal mixer.");
+
+  // list the hardware outputs the loop already reaches
+  first = 1;
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+
+    if (r_snk->elem->port_category != PC_HW)
+      continue;
+
+    int mix = get_upstream_mix(card, r_snk->effective_source_idx);
+    if (mix < 0 || !(loop_mixes & (1 << mix)))
+      continue;
+
+    g_string_append_printf(
+      msg, "%s%s",
+      first ? "\n\nIt is routed to: " : ", ",
+      r_snk->display_name ? r_snk->display_name : r_snk->elem->name
+    );
+    first = 0;
+  }
+
+  g_string_append(
+    msg,
+    "\n\nLower the mixer gains or change the routing to break the loop."
+  );
+
+  if (debug_enabled("mixer-feedback"))
+    printf("MIXER-FEEDBACK: %s\n", msg->str);
+
+  if (card->window_main)
+    show_error(GTK_WINDOW(card->window_main), msg->str);
+
+  g_string_free(msg, TRUE);
+}
+
+static void add_edge(struct alsa_card *card, int u, int v) {
+  struct mixer_feedback *fb = card->mixer_feedback;
+
+  if (fb->edges[u][v]++)
+    return;
+
+  // a new edge u → v closes a loop if v can already reach u
+  if (!(get_reachable(fb, v) & (1 << u)))
+    return;
+
+  int loop_mixes = find_loop_mixes(fb);
+  int grown = loop_mixes & ~fb->loop_mixes;
+
+  fb->loop_mixes = loop_mixes;
+
+  // warn whenever more mixes are on a loop; before the main window
+  // exists, the startup idle warns instead
+  if (grown && card->window_main)
+    warn_loop(card, loop_mixes);
+}
+
+static void remove_edge(struct alsa_card *card, int u, int v) {
+  struct mixer_feedback *fb = card->mixer_feedback;
+
+  if (--fb->edges[u][v] || !fb->loop_mixes)
+    return;
+
+  fb->loop_mixes = find_loop_mixes(fb);
+
+  if (!fb->loop_mixes && debug_enabled("mixer-feedback"))
+    printf("MIXER-FEEDBACK: loop removed\n");
+}
+
+static gboolean warn_startup_loop(gpointer data) {
+  struct alsa_card *card = data;
+  struct mixer_feedback *fb = card->mixer_feedback;
+
+  fb->startup_warning_idle = 0;
+
+  if (fb->loop_mixes)
+    warn_loop(card, fb->loop_mixes);
+
+  return G_SOURCE_REMOVE;
+}
+
+// move a mixer input's edges to a new upstream mix
+static void set_upstream(struct alsa_card *card, int input, int mix) {
+  struct mixer_feedback *fb = card->mixer_feedback;
+  int old = fb->upstream[input];
+
+  if (old == mix)
+    return;
+
+  fb->upstream[input] = mix;
+
+  for (int v = 0; v < MAX_MIX_OUT; v++) {
+    if (!fb->audible[v][input])
+      continue;
+
+    if (old >= 0)
+      remove_edge(card, old, v);
+    if (mix >= 0)
+      add_edge(card, mix, v);
+  }
+}
+
+static void update_input_upstream(struct alsa_card *card, int input) {
+  struct mixer_feedback *fb = card->mixer_feedback;
+  struct routing_snk *r_snk = fb->inputs[input];
+
+  if (!r_snk)
+    return;
+
+  set_upstream(
+    card, input, get_upstream_mix(card, alsa_get_elem_value(r_snk->elem))
+  );
+}
+
+static void mixer_input_changed(struct alsa_elem *elem, void *private) {
+  update_input_upstream(elem->card, elem->lr_num - 1);
+}
+
+// a DSP input change can change the upstream mix of any mixer input
+// fed from the DSP outputs
+static void dsp_input_changed(struct alsa_elem *elem, void *private) {
+  for (int input = 0; input < MAX_MUX_IN; input++)
+    update_input_upstream(elem->card, input);
+}
+
+static void mixer_gain_changed(struct alsa_elem *elem, void *private) {
+  struct alsa_card *card = elem->card;
+  struct mixer_feedback *fb = card->mixer_feedback;
+  int cell = GPOINTER_TO_INT(private) - 1;
+  int mix = cell / MAX_MUX_IN;
+  int input = cell % MAX_MUX_IN;
+
+  int audible = alsa_get_elem_value(elem) > elem->min_val;
+
+  if (audible == fb->audible[mix][input])
+    return;
+
+  fb->audible[mix][input] = audible;
+
+  int u = fb->upstream[input];
+  if (u < 0)
+    return;
+
+  if (audible)
+    add_edge(card, u, mix);
+  else
+    remove_edge(card, u, mix);
+}
+
+void mixer_feedback_init(struct alsa_card *card) {
+  if (!card->routing_snks)
+    return;
+
+  struct mixer_feedback *fb = g_malloc0(sizeof(struct mixer_feedback));
+
+  for (int input = 0; input < MAX_MUX_IN; input++)
+    fb->upstream[input] = -1;
+
+  card->mixer_feedback = fb;
+
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+    struct alsa_elem *elem = r_snk->elem;
+    int input = elem->lr_num - 1;
+
+    if (elem->port_category == PC_MIX &&
+        input >= 0 && input < MAX_MUX_IN) {
+      fb->inputs[input] = r_snk;
+      alsa_elem_add_callback(elem, mixer_input_changed, NULL, NULL);
+    } else if (elem->port_category == PC_DSP) {
+      alsa_elem_add_callback(elem, dsp_input_changed, NULL, NULL);
+    }
+  }
+
+  for (int mix = 0; mix < MAX_MIX_OUT; mix++) {
+    for (int input = 0; input < MAX_MUX_IN; input++) {
+      struct alsa_elem *elem = card->mixer_gains[mix][input];
+
+      if (!elem)
+        continue;
+
+      fb->audible[mix][input] = alsa_get_elem_value(elem) > elem->min_val;
+      alsa_elem_add_callback(
+        elem, mixer_gain_changed, CELL_DATA(mix, input), NULL
+      );
+    }
+  }
+
+  // build the initial edges; the main window doesn't exist yet, so a
+  // loop already present is warned about from an idle, which runs
+  // after the card window has been created
+  for (int input = 0; input < MAX_MUX_IN; input++)
+    update_input_upstream(card, input);
+
+  if (fb->loop_mixes)
+    fb->startup_warning_idle = g_idle_add(warn_startup_loop, card);
+}
+
+void mixer_feedback_free(struct alsa_card *card) {
+  struct mixer_feedback *fb = card->mixer_feedback;
+
+  if (!fb)
+    return;
+
+  if (fb->startup_warning_idle)
+    g_source_remove(fb->startup_warning_idle);
+
+  g_free(fb);
+  card->mixer_feedback = NULL;
+}
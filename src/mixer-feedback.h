@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "alsa.h"
+
+// Feedback loop detection through the internal mixer.
+//
+// A Mix output routed (directly or through the DSP) to a Mixer Input
+// with a non-zero gain into a mix makes an edge between two mixes.
+// The edges are kept up to date from the routing and mixer gain
+// callbacks, and a new edge is only checked for a path back to its
+// start, so each change costs at most a walk over the mixes. The
+// user is warned when more mixes become part of a loop, and about a
+// loop already present at startup once the main window is shown.
+
+// Must be called after alsa_init_mixer_gains_cache()
+void mixer_feedback_init(struct alsa_card *card);
+
+void mixer_feedback_free(struct alsa_card *card);
@@ -1,25 +1,48 @@
 // SPDX-FileCopyrightText: 2022-2025 Geoffrey D. Bennett <g@b4.vu>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
 #include <glib.h>
 #include <glib/gstdio.h>
 
+#include "debug.h"
 #include "optional-state.h"
+#include "state-writer.h"
 
 // Debounce delay in milliseconds
 #define SAVE_DEBOUNCE_MS 100
 
-// Pending save entry with section and key
-struct pending_entry {
-  char *section;
-  char *key;
-  char *value;
-};
+// Journal size at which it is compacted into the state file
+#define JOURNAL_COMPACT_SIZE (64 * 1024)
 
-// Pending saves: serial -> GArray of pending_entry
+// Pending saves: serial -> (section -> (key -> value))
+// Repeated saves of a key overwrite its pending value, so a flush
+// writes at most one record per key
 static GHashTable *pending_saves = NULL;
 static guint save_timeout_id = 0;
 
+// Parsed state file contents, so that the file is only parsed once
+// however many init stages and windows load from it
+struct state_cache {
+
+  // whether the state file exists (or will after the pending saves)
+  gboolean    exists;
+
+  // section -> (key -> value)
+  GHashTable *sections;
+
+  // bytes in the journal (or queued to be written to it) since the
+  // last compaction
+  gsize       journal_size;
+};
+
+// Parsed state files: serial -> struct state_cache
+static GHashTable *state_caches = NULL;
+
+static void maybe_compact(const char *serial, struct state_cache *cache);
+
 // Get the config directory path
 // Returns newly allocated string that must be freed with g_free()
 static char *get_config_dir(void) {
@@ -27,10 +50,11 @@ static char *get_config_dir(void) {
   return g_build_filename(config_home, "alsa-scarlett-gui", NULL);
 }
 
-// Get the state file path for a given serial number
-static char *get_state_path(const char *serial) {
+// Get the path of a file in the config directory for a given serial
+// number
+static char *get_serial_path(const char *serial, const char *ext) {
   char *config_dir = get_config_dir();
-  char *filename = g_strdup_printf("%s.conf", serial);
+  char *filename = g_strdup_printf("%s.%s", serial, ext);
   char *path = g_build_filename(config_dir, filename, NULL);
 
   g_free(config_dir);
@@ -39,6 +63,18 @@ static char *get_state_path(const char *serial) {
   return path;
 }
 
+// Get the state file path for a given serial number
+static char *get_state_path(const char *serial) {
+  return get_serial_path(serial, "conf");
+}
+
+// Get the journal path for a given serial number; changes are
+// appended to the journal and periodically compacted into the state
+// file
+static char *get_journal_path(const char *serial) {
+  return get_serial_path(serial, "journal");
+}
+
 // Create the config directory if it doesn't exist
 // Returns 0 on success, -1 on error
 static int ensure_config_dir(void) {
@@ -54,66 +90,330 @@ static int ensure_config_dir(void) {
   return ret;
 }
 
-// Free a pending entry
-static void free_pending_entry(struct pending_entry *entry) {
-  g_free(entry->section);
-  g_free(entry->key);
-  g_free(entry->value);
-  g_free(entry);
+static void free_state_cache(struct state_cache *cache) {
+  g_hash_table_destroy(cache->sections);
+  g_free(cache);
 }
 
-// Load optional controls from state file using GKeyFile
-GHashTable *optional_state_load(struct alsa_card *card, const char *section) {
-  if (!card || !card->serial || !*card->serial || !section)
-    return NULL;
+// Create a section -> (key -> value) table
+static GHashTable *new_sections(void) {
+  return g_hash_table_new_full(
+    g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_hash_table_destroy
+  );
+}
+
+// Get the key -> value table of a section, creating it if needed
+static GHashTable *get_section(GHashTable *sections, const char *section) {
+  GHashTable *values = g_hash_table_lookup(sections, section);
+
+  if (!values) {
+    values = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    g_hash_table_insert(sections, g_strdup(section), values);
+  }
+
+  return values;
+}
+
+// Set a value in a section -> (key -> value) table
+// Returns TRUE if the value changed
+static gboolean set_section_value(
+  GHashTable *sections,
+  const char *section,
+  const char *key,
+  const char *value
+) {
+  GHashTable *values = get_section(sections, section);
+  const char *old_value = g_hash_table_lookup(values, key);
+
+  if (old_value && !strcmp(old_value, value))
+    return FALSE;
+
+  g_hash_table_insert(values, g_strdup(key), g_strdup(value));
+
+  return TRUE;
+}
+
+// Apply the journal records on top of the parsed state file
+// Each record is one line of tab-separated escaped section, key, and
+// value. An incomplete last line (from a crash during a write) is
+// ignored and cut off (by the state writer, ahead of any later
+// appends) so that later records start on a new line.
+static void replay_journal(struct state_cache *cache, const char *serial) {
+  char *path = get_journal_path(serial);
+  gchar *contents;
+  gsize length;
+
+  if (!g_file_get_contents(path, &contents, &length, NULL)) {
+    g_free(path);
+    return;
+  }
+
+  int count = 0;
+  char *line = contents;
+  char *end;
+
+  while ((end = memchr(line, '\n', contents + length - line))) {
+    *end = '\0';
+
+    gchar **fields = g_strsplit(line, "\t", 3);
+
+    if (g_strv_length(fields) == 3) {
+      gchar *section = g_strcompress(fields[0]);
+
+      g_hash_table_insert(
+        get_section(cache->sections, section),
+        g_strcompress(fields[1]),
+        g_strcompress(fields[2])
+      );
+      g_free(section);
+      cache->exists = TRUE;
+      count++;
+    }
 
-  char *path = get_state_path(card->serial);
+    g_strfreev(fields);
+    line = end + 1;
+  }
+
+  gsize valid = line - contents;
+
+  cache->journal_size = valid;
+
+  if (valid < length)
+    state_writer_write(path, contents, valid, NULL, NULL);
+
+  if (debug_enabled("state-journal"))
+    printf(
+      "STATE-JOURNAL: %s: replayed %d records (%zu bytes)\n",
+      serial, count, valid
+    );
+
+  g_free(contents);
+  g_free(path);
+}
+
+// Parse the state file for a serial and replay its journal
+static struct state_cache *parse_state_file(const char *serial) {
+  struct state_cache *cache = g_malloc0(sizeof(struct state_cache));
+
+  cache->sections = new_sections();
+
+  char *path = get_state_path(serial);
   GKeyFile *key_file = g_key_file_new();
-  GError *error = NULL;
 
-  // try to load the file
-  if (!g_key_file_load_from_file(key_file, path, G_KEY_FILE_NONE, &error)) {
-    // file doesn't exist or can't be read - not an error
+  // file doesn't exist or can't be read - not an error
+  if (!g_key_file_load_from_file(key_file, path, G_KEY_FILE_NONE, NULL)) {
     g_key_file_free(key_file);
     g_free(path);
-    if (error)
-      g_error_free(error);
-    return NULL;
+    replay_journal(cache, serial);
+    return cache;
   }
 
   g_free(path);
+  cache->exists = TRUE;
+
+  gchar **groups = g_key_file_get_groups(key_file, NULL);
+
+  for (gchar **group = groups; *group; group++) {
+    GHashTable *values = get_section(cache->sections, *group);
+    gchar **keys = g_key_file_get_keys(key_file, *group, NULL, NULL);
+
+    if (!keys)
+      continue;
+
+    for (gchar **key = keys; *key; key++) {
+      gchar *value = g_key_file_get_string(key_file, *group, *key, NULL);
+
+      if (value)
+        g_hash_table_insert(values, g_strdup(*key), value);
+    }
+
+    g_strfreev(keys);
+  }
 
-  // create hash table for values
+  g_strfreev(groups);
+  g_key_file_free(key_file);
+
+  replay_journal(cache, serial);
+
+  return cache;
+}
+
+// Get the parsed state file for a serial, parsing it on first use
+static struct state_cache *get_state_cache(const char *serial) {
+  if (!state_caches)
+    state_caches = g_hash_table_new_full(
+      g_str_hash, g_str_equal, g_free, (GDestroyNotify)free_state_cache
+    );
+
+  struct state_cache *cache = g_hash_table_lookup(state_caches, serial);
+
+  if (cache)
+    return cache;
+
+  // the files are read directly, so let the queued writes to them
+  // (appends, compactions, removals) finish first; this runs the
+  // main loop, which may parse the files in the meantime
+  state_writer_flush();
+
+  cache = g_hash_table_lookup(state_caches, serial);
+
+  if (!cache) {
+    cache = parse_state_file(serial);
+    g_hash_table_insert(state_caches, g_strdup(serial), cache);
+    maybe_compact(serial, cache);
+  }
+
+  return cache;
+}
+
+// Load optional controls from the parsed state file
+GHashTable *optional_state_load(struct alsa_card *card, const char *section) {
+  if (!card || !card->serial || !*card->serial || !section)
+    return NULL;
+
+  struct state_cache *cache = get_state_cache(card->serial);
+
+  if (!cache->exists)
+    return NULL;
+
+  // return a copy; the caller owns it
   GHashTable *values = g_hash_table_new_full(
     g_str_hash, g_str_equal, g_free, g_free
   );
 
-  // get all keys from the specified section
-  gsize num_keys;
-  gchar **keys = g_key_file_get_keys(key_file, section, &num_keys, &error);
-
-  if (!keys) {
-    if (error)
-      g_error_free(error);
-    g_key_file_free(key_file);
+  GHashTable *cached = g_hash_table_lookup(cache->sections, section);
+  if (!cached)
     return values;
+
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_hash_table_iter_init(&iter, cached);
+  while (g_hash_table_iter_next(&iter, &key, &value))
+    g_hash_table_insert(values, g_strdup(key), g_strdup(value));
+
+  return values;
+}
+
+// Queue the pending values of a serial to be appended to its
+// journal with a single fsync
+static void append_journal(
+  const char         *serial,
+  struct state_cache *cache,
+  GHashTable         *sections
+) {
+  GString *records = g_string_new(NULL);
+  int count = 0;
+
+  GHashTableIter section_iter;
+  gpointer section_name, values;
+
+  g_hash_table_iter_init(&section_iter, sections);
+  while (g_hash_table_iter_next(&section_iter, &section_name, &values)) {
+    gchar *section = g_strescape(section_name, NULL);
+    GHashTableIter iter;
+    gpointer key_name, value_str;
+
+    g_hash_table_iter_init(&iter, values);
+    while (g_hash_table_iter_next(&iter, &key_name, &value_str)) {
+      gchar *key = g_strescape(key_name, NULL);
+      gchar *value = g_strescape(value_str, NULL);
+
+      g_string_append_printf(records, "%s\t%s\t%s\n", section, key, value);
+      count++;
+
+      g_free(key);
+      g_free(value);
+    }
+
+    g_free(section);
   }
 
-  // read each key-value pair
-  for (gsize i = 0; i < num_keys; i++) {
-    gchar *value = g_key_file_get_string(key_file, section, keys[i], NULL);
+  char *path = get_journal_path(serial);
 
-    if (value)
-      g_hash_table_insert(values, g_strdup(keys[i]), value);
+  state_writer_append(path, records->str, records->len, NULL, NULL);
+  cache->journal_size += records->len;
+
+  if (debug_enabled("state-journal"))
+    printf(
+      "STATE-JOURNAL: %s: appending %d records (%zu bytes)\n",
+      serial, count, records->len
+    );
+
+  g_free(path);
+  g_string_free(records, TRUE);
+}
+
+// Add a section -> (key -> value) table to a key file
+static void add_key_file_section(
+  GKeyFile   *key_file,
+  const char *section,
+  GHashTable *values
+) {
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_hash_table_iter_init(&iter, values);
+  while (g_hash_table_iter_next(&iter, &key, &value))
+    g_key_file_set_string(key_file, section, key, value);
+}
+
+// The journal records are all in the state file written by a
+// compaction; the journal can go. Writes queued after the compaction
+// don't start until this returns.
+static void compact_done(const GError *error, gpointer data) {
+  char *serial = data;
+
+  if (!error) {
+    char *path = get_journal_path(serial);
+
+    if (g_unlink(path) < 0 && errno != ENOENT)
+      g_warning("Failed to remove journal %s", path);
+
+    if (debug_enabled("state-journal"))
+      printf("STATE-JOURNAL: %s: compacted\n", serial);
+
+    g_free(path);
   }
 
-  g_strfreev(keys);
-  g_key_file_free(key_file);
+  g_free(serial);
+}
 
-  return values;
+// Compact the journal of a serial into its state file once it has
+// grown large enough
+// The key file is built from the parsed state here, which includes
+// every record queued for the journal so far, and written by the
+// state writer after those records.
+static void maybe_compact(const char *serial, struct state_cache *cache) {
+  if (cache->journal_size < JOURNAL_COMPACT_SIZE)
+    return;
+
+  GKeyFile *key_file = g_key_file_new();
+
+  // keep the device section first
+  GHashTable *device = g_hash_table_lookup(
+    cache->sections, CONFIG_SECTION_DEVICE
+  );
+  if (device)
+    add_key_file_section(key_file, CONFIG_SECTION_DEVICE, device);
+
+  GHashTableIter iter;
+  gpointer section, values;
+
+  g_hash_table_iter_init(&iter, cache->sections);
+  while (g_hash_table_iter_next(&iter, &section, &values))
+    if (values != device)
+      add_key_file_section(key_file, section, values);
+
+  char *path = get_state_path(serial);
+
+  state_writer_save(key_file, path, compact_done, g_strdup(serial));
+  cache->journal_size = 0;
+
+  g_free(path);
 }
 
-// Flush all pending saves to disk
+// Flush all pending saves to the journals
 static gboolean flush_pending_saves(gpointer user_data) {
   save_timeout_id = 0;
 
@@ -130,35 +430,11 @@ static gboolean flush_pending_saves(gpointer user_data) {
   g_hash_table_iter_init(&serial_iter, pending_saves);
   while (g_hash_table_iter_next(&serial_iter, &serial_key, &serial_value)) {
     const char *serial = serial_key;
-    GArray *entries = serial_value;
-
-    char *path = get_state_path(serial);
-    GKeyFile *key_file = g_key_file_new();
-    GError *error = NULL;
-
-    // load existing file if it exists
-    g_key_file_load_from_file(key_file, path, G_KEY_FILE_NONE, NULL);
-
-    // apply all pending changes for this serial
-    for (guint i = 0; i < entries->len; i++) {
-      struct pending_entry *entry = g_array_index(entries, struct pending_entry *, i);
-
-      g_key_file_set_string(
-        key_file,
-        entry->section,
-        entry->key,
-        entry->value ? entry->value : ""
-      );
-    }
-
-    // save to file
-    if (!g_key_file_save_to_file(key_file, path, &error)) {
-      g_warning("Failed to save state file %s: %s", path, error->message);
-      g_error_free(error);
-    }
+    GHashTable *sections = serial_value;
+    struct state_cache *cache = get_state_cache(serial);
 
-    g_key_file_free(key_file);
-    g_free(path);
+    append_journal(serial, cache, sections);
+    maybe_compact(serial, cache);
   }
 
   // clear all pending saves
@@ -167,13 +443,25 @@ static gboolean flush_pending_saves(gpointer user_data) {
   return G_SOURCE_REMOVE;
 }
 
-// Free array of pending entries
-static void free_pending_entries(GArray *entries) {
-  for (guint i = 0; i < entries->len; i++) {
-    struct pending_entry *entry = g_array_index(entries, struct pending_entry *, i);
-    free_pending_entry(entry);
+// Remove the state file, journal, pending saves, and parsed state
+// of a serial on the main thread, after any queued writes
+static gboolean remove_state(gpointer data) {
+  const char *serial = data;
+
+  if (pending_saves)
+    g_hash_table_remove(pending_saves, serial);
+
+  if (state_caches)
+    g_hash_table_remove(state_caches, serial);
+
+  char *paths[] = { get_state_path(serial), get_journal_path(serial) };
+
+  for (int i = 0; i < G_N_ELEMENTS(paths); i++) {
+    state_writer_remove(paths[i], NULL, NULL);
+    g_free(paths[i]);
   }
-  g_array_free(entries, TRUE);
+
+  return G_SOURCE_REMOVE;
 }
 
 // Remove the state file for a given serial
@@ -181,18 +469,32 @@ int optional_state_remove(const char *serial) {
   if (!serial || !*serial)
     return -1;
 
-  char *path = get_state_path(serial);
-  int ret = 0;
+  // may be called from a worker thread
+  g_main_context_invoke_full(
+    NULL, G_PRIORITY_DEFAULT, remove_state, g_strdup(serial), g_free
+  );
 
-  if (g_file_test(path, G_FILE_TEST_EXISTS)) {
-    if (g_unlink(path) < 0) {
-      g_warning("Failed to remove state file: %s", path);
-      ret = -1;
-    }
-  }
+  return 0;
+}
 
-  g_free(path);
-  return ret;
+// Drop the parsed state file of a card that has gone away, so that
+// it is re-read if the card comes back. Pending saves are written
+// first so they aren't lost.
+void optional_state_forget(struct alsa_card *card) {
+  if (!card || !card->serial || !*card->serial || !state_caches)
+    return;
+
+  optional_state_flush();
+
+  g_hash_table_remove(state_caches, card->serial);
+}
+
+void optional_state_flush(void) {
+  if (!save_timeout_id)
+    return;
+
+  g_source_remove(save_timeout_id);
+  flush_pending_saves(NULL);
 }
 
 // Save optional control state to file using GKeyFile (debounced)
@@ -207,56 +509,45 @@ int optional_state_save(
 
   const char *serial = card->serial;
 
+  if (!value)
+    value = "";
+
+  // nothing to save if the state already has this value
+  struct state_cache *cache = get_state_cache(serial);
+  if (!set_section_value(cache->sections, section, key, value))
+    return 0;
+
+  cache->exists = TRUE;
+
   // initialise pending_saves hash table if needed
   if (!pending_saves) {
     pending_saves = g_hash_table_new_full(
       g_str_hash, g_str_equal,
       g_free,
-      (GDestroyNotify)free_pending_entries
+      (GDestroyNotify)g_hash_table_destroy
     );
   }
 
-  // get or create the array for this serial
-  GArray *entries = g_hash_table_lookup(pending_saves, serial);
-  if (!entries) {
-    entries = g_array_new(FALSE, FALSE, sizeof(struct pending_entry *));
-    g_hash_table_insert(pending_saves, g_strdup(serial), entries);
+  // get or create the pending values for this serial
+  GHashTable *pending = g_hash_table_lookup(pending_saves, serial);
+  if (!pending) {
+    pending = new_sections();
+    g_hash_table_insert(pending_saves, g_strdup(serial), pending);
   }
 
-  // create new pending entry
-  struct pending_entry *entry = g_malloc(sizeof(struct pending_entry));
-  entry->section = g_strdup(section);
-  entry->key = g_strdup(key);
-  entry->value = g_strdup(value ? value : "");
-
-  g_array_append_val(entries, entry);
+  set_section_value(pending, section, key, value);
 
   // also ensure [device] section has serial and model
-  // (add these first time we save anything for this serial)
-  static GHashTable *device_section_written = NULL;
-  if (!device_section_written) {
-    device_section_written = g_hash_table_new_full(
-      g_str_hash, g_str_equal, g_free, NULL
-    );
-  }
-
-  if (!g_hash_table_contains(device_section_written, serial)) {
-    g_hash_table_add(device_section_written, g_strdup(serial));
-
-    struct pending_entry *serial_entry = g_malloc(sizeof(struct pending_entry));
-    serial_entry->section = g_strdup(CONFIG_SECTION_DEVICE);
-    serial_entry->key = g_strdup("serial");
-    serial_entry->value = g_strdup(serial);
-    g_array_append_val(entries, serial_entry);
-
-    if (card->name) {
-      struct pending_entry *model_entry = g_malloc(sizeof(struct pending_entry));
-      model_entry->section = g_strdup(CONFIG_SECTION_DEVICE);
-      model_entry->key = g_strdup("model");
-      model_entry->value = g_strdup(card->name);
-      g_array_append_val(entries, model_entry);
-    }
-  }
+  if (set_section_value(
+    cache->sections, CONFIG_SECTION_DEVICE, "serial", serial
+  ))
+    set_section_value(pending, CONFIG_SECTION_DEVICE, "serial", serial);
+
+  if (card->name &&
+      set_section_value(
+        cache->sections, CONFIG_SECTION_DEVICE, "model", card->name
+      ))
+    set_section_value(pending, CONFIG_SECTION_DEVICE, "model", card->name);
 
   // cancel existing timeout if any
   if (save_timeout_id)
@@ -11,6 +11,8 @@
 #define CONFIG_SECTION_UI       "ui"
 
 // Load the optional control state for a device from a specific section
+// The state file is parsed once per card and kept coherent with
+// optional_state_save()
 // Returns hash table of key → value (as string)
 // Caller must free the hash table with g_hash_table_destroy()
 // Returns NULL if card has no serial or file doesn't exist
@@ -26,6 +28,16 @@ int optional_state_save(
   const char       *value
 );
 
+// Queue the saves still waiting for the debounce timeout
+// (call before state_writer_flush() at exit)
+void optional_state_flush(void);
+
+// Drop the parsed state file of a card being removed (writes any
+// pending saves first)
+void optional_state_forget(struct alsa_card *card);
+
 // Remove the state file for a given serial
+// Can be called from any thread; the removal is queued after any
+// pending writes
 // Returns 0 on success, -1 on error
 int optional_state_remove(const char *serial);
@@ -26,6 +26,10 @@
 
 #define SAMPLE_RATE 48000.0
 
+// Response curves are sampled at log-spaced frequencies from
+// FREQ_MIN, each RESPONSE_STEP times the previous, up to FREQ_MAX
+#define RESPONSE_STEP 1.02
+
 // Band colors (up to 8)
 static const double band_colors[][3] = {
   { 0.4, 0.7, 0.9 },  // blue
@@ -51,6 +55,13 @@ struct _GtkFilterResponse {
   int num_bands;
   struct biquad_params bands[FILTER_RESPONSE_MAX_BANDS];
   struct biquad_coeffs coeffs[FILTER_RESPONSE_MAX_BANDS];
+
+  // Cached per-band response in dB at response_freqs[]
+  // (response_points values per band); only recalculated when that
+  // band's coefficients change
+  double *band_db;
+  double *combined_db;
+  gboolean band_db_valid[FILTER_RESPONSE_MAX_BANDS];
   gboolean band_enabled[FILTER_RESPONSE_MAX_BANDS];
   gboolean dsp_enabled;  // overall DSP enable state
   double db_range;  // DB_RANGE_NARROW or GAIN_DB_LIMIT
@@ -66,6 +77,15 @@ struct _GtkFilterResponse {
 
 G_DEFINE_TYPE(GtkFilterResponse, gtk_filter_response, GTK_TYPE_WIDGET)
 
+// Response sample frequencies, and their position (0-1) along the
+// log frequency axis; set up in class_init
+static int     response_points;
+static double *response_freqs;
+static double *response_pos;
+
+// Precomputed trig terms for response_freqs[]
+static struct biquad_freq_table response_table;
+
 enum {
   SIGNAL_FILTER_CHANGED,
   SIGNAL_HIGHLIGHT_CHANGED,
@@ -74,6 +94,15 @@ enum {
 
 static guint signals[N_SIGNALS];
 
+// Recalculate the coefficients for a band after its parameters
+// changed, and invalidate its cached response curve
+static void update_band_coeffs(GtkFilterResponse *response, int band) {
+  biquad_calculate(
+    &response->bands[band], SAMPLE_RATE, &response->coeffs[band]
+  );
+  response->band_db_valid[band] = FALSE;
+}
+
 // Calculate graph area from widget dimensions
 static void calc_graph_area(
   int width, int height, double db_range, struct graph_area *g
@@ -147,16 +176,30 @@ static double y_to_q(const struct graph_area *g, double y) {
   return pow(10.0, log_q);
 }
 
+// Build the path through a response curve sampled at response_freqs[]
+static void response_path(
+  cairo_t                 *cr,
+  const struct graph_area *g,
+  const double            *db
+) {
+  for (int i = 0; i < response_points; i++)
+    cairo_line_to(
+      cr,
+      g->left + response_pos[i] * g->width,
+      db_to_y(g, db[i])
+    );
+}
+
 // Draw a single filter response curve with shading to 0 dB line
 static void draw_filter_response(
-  cairo_t                    *cr,
-  const struct graph_area    *g,
-  const struct biquad_coeffs *coeffs,
-  double                      r,
-  double                      gc,
-  double                      b,
-  double                      alpha,
-  gboolean                    dashed
+  cairo_t                 *cr,
+  const struct graph_area *g,
+  const double            *db,
+  double                   r,
+  double                   gc,
+  double                   b,
+  double                   alpha,
+  gboolean                 dashed
 ) {
   cairo_save(cr);
 
@@ -166,12 +209,7 @@ static void draw_filter_response(
 
   // Build closed path for fill
   cairo_move_to(cr, x_start, y0);
-  for (double freq = FREQ_MIN; freq <= FREQ_MAX; freq *= 1.02) {
-    double db = biquad_response_db(coeffs, freq, SAMPLE_RATE);
-    double x = freq_to_x(g, freq);
-    double y = db_to_y(g, db);
-    cairo_line_to(cr, x, y);
-  }
+  response_path(cr, g, db);
   cairo_line_to(cr, x_end, y0);
   cairo_close_path(cr);
 
@@ -180,18 +218,8 @@ static void draw_filter_response(
   cairo_fill(cr);
 
   // Build new path for stroke (curve only)
-  gboolean first = TRUE;
-  for (double freq = FREQ_MIN; freq <= FREQ_MAX; freq *= 1.02) {
-    double db = biquad_response_db(coeffs, freq, SAMPLE_RATE);
-    double x = freq_to_x(g, freq);
-    double y = db_to_y(g, db);
-    if (first) {
-      cairo_move_to(cr, x, y);
-      first = FALSE;
-    } else {
-      cairo_line_to(cr, x, y);
-    }
-  }
+  cairo_new_path(cr);
+  response_path(cr, g, db);
 
   cairo_set_source_rgba(cr, r, gc, b, alpha);
   cairo_set_line_width(cr, 1.5);
@@ -417,9 +445,7 @@ void gtk_filter_response_set_db_range(
         params->gain_db > new_range) {
       params->gain_db = CLAMP(params->gain_db,
                               -new_range, new_range);
-      biquad_calculate(
-        params, SAMPLE_RATE, &response->coeffs[i]
-      );
+      update_band_coeffs(response, i);
       g_signal_emit(
         response, signals[SIGNAL_FILTER_CHANGED], 0, i, params
       );
@@ -527,7 +553,7 @@ static void response_drag_update(
   }
 
   // Recalculate coefficients
-  biquad_calculate(params, SAMPLE_RATE, &response->coeffs[response->drag_band]);
+  update_band_coeffs(response, response->drag_band);
 
   // Emit signal to notify external code
   g_signal_emit(response, signals[SIGNAL_FILTER_CHANGED], 0,
@@ -574,7 +600,7 @@ static gboolean response_scroll(
   params->q = new_q;
 
   // Recalculate coefficients
-  biquad_calculate(params, SAMPLE_RATE, &response->coeffs[band]);
+  update_band_coeffs(response, band);
 
   // Emit signal to notify external code
   g_signal_emit(response, signals[SIGNAL_FILTER_CHANGED], 0, band, params);
@@ -584,16 +610,37 @@ static gboolean response_scroll(
   return TRUE;
 }
 
-// Calculate combined response at a frequency (includes all enabled bands)
-static double combined_response_db(GtkFilterResponse *response, double freq) {
-  double total_db = 0.0;
+// Get the response curve of a band, recalculating it if the
+// coefficients have changed
+static const double *get_band_response(
+  GtkFilterResponse *response,
+  int                band
+) {
+  double *db = response->band_db + band * response_points;
 
-  for (int i = 0; i < response->num_bands; i++) {
-    if (response->band_enabled[i])
-      total_db += biquad_response_db(&response->coeffs[i], freq, SAMPLE_RATE);
+  if (!response->band_db_valid[band]) {
+    biquad_response_db_batch(
+      &response->coeffs[band], 1, &response_table, TRUE, db
+    );
+    response->band_db_valid[band] = TRUE;
   }
 
-  return total_db;
+  return db;
+}
+
+// Calculate combined response (sum of all enabled bands)
+static void combined_response_db(GtkFilterResponse *response, double *db) {
+  for (int i = 0; i < response_points; i++)
+    db[i] = 0.0;
+
+  for (int band = 0; band < response->num_bands; band++) {
+    if (!response->band_enabled[band])
+      continue;
+
+    const double *band_db = get_band_response(response, band);
+    for (int i = 0; i < response_points; i++)
+      db[i] += band_db[i];
+  }
 }
 
 static void response_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
@@ -687,7 +734,7 @@ static void response_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
     int color_idx = i % 8;
     gboolean band_on = response->band_enabled[i] && response->dsp_enabled;
     draw_filter_response(
-      cr, &g, &response->coeffs[i],
+      cr, &g, get_band_response(response, i),
       band_colors[color_idx][0],
       band_colors[color_idx][1],
       band_colors[color_idx][2],
@@ -708,19 +755,9 @@ static void response_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
     cairo_set_dash(cr, dashes, 2, 0);
   }
 
-  gboolean first = TRUE;
-  for (double freq = FREQ_MIN; freq <= FREQ_MAX; freq *= 1.02) {
-    double db = combined_response_db(response, freq);
-    double x = freq_to_x(&g, freq);
-    double y = db_to_y(&g, db);
-
-    if (first) {
-      cairo_move_to(cr, x, y);
-      first = FALSE;
-    } else {
-      cairo_line_to(cr, x, y);
-    }
-  }
+  combined_response_db(response, response->combined_db);
+  cairo_new_path(cr);
+  response_path(cr, &g, response->combined_db);
   cairo_stroke(cr);
   cairo_restore(cr);
 
@@ -731,7 +768,7 @@ static void response_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
     int color_idx = i % 8;
     gboolean band_on = response->band_enabled[i] && response->dsp_enabled;
     draw_filter_response(
-      cr, &g, &response->coeffs[i],
+      cr, &g, get_band_response(response, i),
       band_colors[color_idx][0],
       band_colors[color_idx][1],
       band_colors[color_idx][2],
@@ -829,9 +866,43 @@ static void response_measure(
   *natural_baseline = -1;
 }
 
+static void gtk_filter_response_finalize(GObject *object) {
+  GtkFilterResponse *response = GTK_FILTER_RESPONSE(object);
+
+  g_free(response->band_db);
+  g_free(response->combined_db);
+
+  G_OBJECT_CLASS(gtk_filter_response_parent_class)->finalize(object);
+}
+
 static void gtk_filter_response_class_init(GtkFilterResponseClass *klass) {
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
 
+  // Response sample frequencies (same steps as the original
+  // freq *= RESPONSE_STEP loop); count them first so the tables
+  // follow FREQ_MIN, FREQ_MAX, and RESPONSE_STEP
+  double log_min = log10(FREQ_MIN);
+  double log_max = log10(FREQ_MAX);
+  double freq;
+
+  response_points = 0;
+  for (freq = FREQ_MIN; freq <= FREQ_MAX; freq *= RESPONSE_STEP)
+    response_points++;
+
+  response_freqs = g_malloc(response_points * sizeof(double));
+  response_pos = g_malloc(response_points * sizeof(double));
+
+  freq = FREQ_MIN;
+  for (int i = 0; i < response_points; i++, freq *= RESPONSE_STEP) {
+    response_freqs[i] = freq;
+    response_pos[i] = (log10(freq) - log_min) / (log_max - log_min);
+  }
+  biquad_freq_table_init(
+    &response_table, response_freqs, response_points, SAMPLE_RATE
+  );
+
+  G_OBJECT_CLASS(klass)->finalize = gtk_filter_response_finalize;
+
   widget_class->snapshot = response_snapshot;
   widget_class->measure = response_measure;
 
@@ -871,6 +942,11 @@ static void gtk_filter_response_init(GtkFilterResponse *response) {
   response->internal_highlight = -1;
   response->drag_band = -1;
 
+  response->band_db = g_malloc(
+    FILTER_RESPONSE_MAX_BANDS * response_points * sizeof(double)
+  );
+  response->combined_db = g_malloc(response_points * sizeof(double));
+
   for (int i = 0; i < FILTER_RESPONSE_MAX_BANDS; i++) {
     response->band_enabled[i] = TRUE;
     response->bands[i].type = BIQUAD_TYPE_PEAKING;
@@ -911,11 +987,8 @@ GtkWidget *gtk_filter_response_new(int num_bands) {
   response->num_bands = num_bands;
 
   // Initialize coefficients for all bands
-  for (int i = 0; i < num_bands; i++) {
-    biquad_calculate(
-      &response->bands[i], SAMPLE_RATE, &response->coeffs[i]
-    );
-  }
+  for (int i = 0; i < num_bands; i++)
+    update_band_coeffs(response, i);
 
   return GTK_WIDGET(response);
 }
@@ -929,7 +1002,7 @@ void gtk_filter_response_set_filter(
     return;
 
   response->bands[band] = *params;
-  biquad_calculate(params, SAMPLE_RATE, &response->coeffs[band]);
+  update_band_coeffs(response, band);
   gtk_widget_queue_draw(GTK_WIDGET(response));
 }
 
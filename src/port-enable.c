@@ -52,6 +52,9 @@ static gboolean flush_pending_ui_updates(gpointer user_data) {
   if (card->pending_ui_updates & PENDING_UI_UPDATE_MONITOR_GROUPS)
     rebuild_monitor_groups_grid(card);
 
+  if (card->pending_ui_updates & PENDING_UI_UPDATE_ROUTING)
+    flush_routing_ui_update(card);
+
   card->pending_ui_updates = 0;
 
   return G_SOURCE_REMOVE;
@@ -200,6 +203,9 @@ void update_routing_section_visibility(struct alsa_card *card) {
   // Update the Sources and Sinks label arrows
   update_sources_label(card);
   update_sinks_label(card);
+
+  // enabled and linked ports are hit-tested differently
+  routing_hit_index_invalidate(card);
 }
 
 // Callback to update routing source visibility
@@ -1,19 +1,37 @@
 // SPDX-FileCopyrightText: 2022-2025 Geoffrey D. Bennett <g@b4.vu>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <sys/inotify.h>
+#include <unistd.h>
 #include <gdk/gdk.h>
 #include <glib/gstdio.h>
 #include <graphene.h>
 
+#include "debug.h"
 #include "error.h"
 #include "file.h"
 #include "presets.h"
 
 // Data structure for the presets button and popover
 struct presets_data {
-  struct alsa_card *card;
-  GtkWidget        *popover;
-  GtkWidget        *box;
+  struct alsa_card    *card;
+  GtkWidget           *popover;
+  GtkWidget           *box;
+
+  // the index generation the box was last populated from
+  struct preset_index *index;
+  guint                generation;
+
+  // preset name -> struct native_config read and resolved in the
+  // background (NULL if it couldn't be read)
+  GHashTable          *prefetched;
+
+  // the preset being read, and whether its file changed meanwhile
+  char                *prefetching;
+  gboolean             prefetch_stale;
+
+  // cancelled when the button is destroyed
+  GCancellable        *prefetch_cancellable;
 };
 
 // Helper to attach preset name to a widget
@@ -63,6 +81,26 @@ static int ensure_presets_dir(void) {
   return ret;
 }
 
+// Get the preset name from a filename in the presets directory if
+// it is a preset of the given serial ("{serial}-{name}.conf")
+// Returns a newly allocated string, or NULL
+static char *get_preset_name(const char *serial, const char *filename) {
+  size_t serial_len = strlen(serial);
+  size_t len = strlen(filename);
+  size_t suffix_len = strlen(".conf");
+
+  if (len <= serial_len + 1 + suffix_len ||
+      strncmp(filename, serial, serial_len) != 0 ||
+      filename[serial_len] != '-' ||
+      !g_str_has_suffix(filename, ".conf"))
+    return NULL;
+
+  return g_strndup(
+    filename + serial_len + 1,
+    len - serial_len - 1 - suffix_len
+  );
+}
+
 // Scan for presets matching the card's serial number
 // Returns a GList of preset names (newly allocated strings)
 static GList *scan_presets(const char *serial) {
@@ -75,40 +113,453 @@ static GList *scan_presets(const char *serial) {
     return NULL;
   }
 
-  // Build the prefix to match: "{serial}-"
-  char *prefix = g_strdup_printf("%s-", serial);
-  size_t prefix_len = strlen(prefix);
-
   const char *filename;
   while ((filename = g_dir_read_name(dir)) != NULL) {
-    // Check if filename starts with prefix and ends with .conf
-    if (g_str_has_prefix(filename, prefix) &&
-        g_str_has_suffix(filename, ".conf")) {
-      // Extract preset name from filename (remove ".conf" suffix)
-      size_t len = strlen(filename);
-      char *name = g_strndup(filename + prefix_len, len - prefix_len - strlen(".conf"));
+    char *name = get_preset_name(serial, filename);
+
+    if (name)
       presets = g_list_insert_sorted(presets, name, (GCompareFunc)g_strcmp0);
-    }
   }
 
   g_dir_close(dir);
-  g_free(prefix);
   g_free(presets_dir);
 
   return presets;
 }
 
-// Load a preset
-static void load_preset(struct alsa_card *card, const char *name) {
-  char *path = get_preset_path(card->serial, name);
+// The preset names of each serial are scanned once on a worker
+// thread and then kept up to date from inotify events on the presets
+// directory, so showing the popover doesn't touch the filesystem
+struct preset_index {
+  char     *serial;
+
+  // sorted preset names; NULL until the first scan has finished
+  GList    *names;
+
+  // incremented each time names changes
+  guint     generation;
+
+  // a scan is running; changes seen meanwhile need another scan as
+  // the running one may have read the directory before them
+  gboolean  scanning;
+  gboolean  rescan;
+
+  // the presets_data of each Presets button for this serial
+  GList    *listeners;
+};
+
+// serial -> struct preset_index
+static GHashTable *preset_indexes;
+
+// inotify fd and watch for the presets directory, or -1; without
+// them, the index is rescanned each time a popover is shown
+static int presets_inotify_fd = -1;
+static int presets_inotify_wd = -1;
+
+static void populate_presets_list(struct presets_data *data);
+static void prefetch_invalidate(struct presets_data *data, const char *name);
+
+// Tell the Presets buttons of an index that a preset file has
+// changed (or any of them, if name is NULL), and refresh the open
+// popovers if the list of names changed; closed ones are refreshed
+// when next shown
+static void preset_index_changed(
+  struct preset_index *index,
+  const char          *name,
+  gboolean             names_changed
+) {
+  if (names_changed)
+    index->generation++;
+
+  for (GList *l = index->listeners; l; l = l->next) {
+    struct presets_data *data = l->data;
+
+    if (names_changed && gtk_widget_get_visible(data->popover))
+      populate_presets_list(data);
+
+    prefetch_invalidate(data, name);
+  }
+}
+
+static void preset_index_scan_thread(
+  GTask        *task,
+  gpointer      source_object,
+  gpointer      task_data,
+  GCancellable *cancellable
+) {
+  g_task_return_pointer(task, scan_presets(task_data), NULL);
+}
+
+static void preset_index_scan(struct preset_index *index);
+
+static void preset_index_scan_done(
+  GObject      *source_object,
+  GAsyncResult *result,
+  gpointer      user_data
+) {
+  struct preset_index *index = user_data;
+  GList *names = g_task_propagate_pointer(G_TASK(result), NULL);
+
+  index->scanning = FALSE;
+
+  g_list_free_full(index->names, g_free);
+  index->names = names;
+
+  if (debug_enabled("presets"))
+    printf(
+      "PRESETS: indexed %u presets for %s\n",
+      g_list_length(names), index->serial
+    );
+
+  preset_index_changed(index, NULL, TRUE);
+
+  if (index->rescan)
+    preset_index_scan(index);
+}
+
+static void preset_index_scan(struct preset_index *index) {
+  if (index->scanning) {
+    index->rescan = TRUE;
+    return;
+  }
+
+  index->scanning = TRUE;
+  index->rescan = FALSE;
+
+  GTask *task = g_task_new(NULL, NULL, preset_index_scan_done, index);
+  g_task_set_task_data(task, g_strdup(index->serial), g_free);
+  g_task_run_in_thread(task, preset_index_scan_thread);
+  g_object_unref(task);
+}
+
+// Rescan every index
+static void preset_indexes_scan(void) {
+  GHashTableIter iter;
+  struct preset_index *index;
+
+  g_hash_table_iter_init(&iter, preset_indexes);
+  while (g_hash_table_iter_next(&iter, NULL, (gpointer *)&index))
+    preset_index_scan(index);
+}
+
+// Add or remove a name in an index after a change to its file
+static void preset_index_update(
+  struct preset_index *index,
+  const char          *name,
+  gboolean             exists
+) {
+
+  // the scan result will include the change
+  if (index->scanning) {
+    index->rescan = TRUE;
+    return;
+  }
+
+  GList *l = g_list_find_custom(index->names, name, (GCompareFunc)g_strcmp0);
+
+  // the contents changed
+  if (exists == (l != NULL)) {
+    preset_index_changed(index, name, FALSE);
+    return;
+  }
+
+  if (exists) {
+    index->names = g_list_insert_sorted(
+      index->names, g_strdup(name), (GCompareFunc)g_strcmp0
+    );
+  } else {
+    g_free(l->data);
+    index->names = g_list_delete_link(index->names, l);
+  }
+
+  if (debug_enabled("presets"))
+    printf(
+      "PRESETS: %s \"%s\" for %s\n",
+      exists ? "added" : "removed", name, index->serial
+    );
+
+  preset_index_changed(index, name, TRUE);
+}
+
+// Watch the presets directory, creating it if needed (it must exist
+// to be watched)
+static int presets_inotify_add_watch(void) {
+  char *presets_dir = get_presets_dir();
+
+  ensure_presets_dir();
+
+  presets_inotify_wd = inotify_add_watch(
+    presets_inotify_fd, presets_dir,
+    IN_CREATE | IN_CLOSE_WRITE | IN_DELETE |
+      IN_MOVED_FROM | IN_MOVED_TO |
+      IN_DELETE_SELF | IN_MOVE_SELF
+  );
+  if (presets_inotify_wd < 0)
+    perror("presets inotify_add_watch");
+
+  g_free(presets_dir);
+  return presets_inotify_wd < 0 ? -1 : 0;
+}
+
+static gboolean presets_inotify_callback(
+  GIOChannel    *source,
+  GIOCondition  condition,
+  void          *data
+) {
+  char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  const struct inotify_event *event;
+  int len;
+
+  len = read(presets_inotify_fd, &buf, sizeof(buf));
+  if (len < 0) {
+    perror("presets inotify read");
+    return TRUE;
+  }
+
+  for (
+    event = (struct inotify_event *)buf;
+    (char *)event < buf + len;
+    event = (struct inotify_event *)
+              ((char *)event + sizeof(*event) + event->len)
+  ) {
+    GHashTableIter iter;
+    struct preset_index *index;
+
+    // the directory was moved away; stop following it (IN_IGNORED
+    // follows)
+    if (event->wd == presets_inotify_wd && (event->mask & IN_MOVE_SELF)) {
+      inotify_rm_watch(presets_inotify_fd, presets_inotify_wd);
+      continue;
+    }
+
+    // the watch is gone (the directory was deleted, moved away, or
+    // unmounted); watch the directory again and start again, or
+    // fall back to rescanning when the popovers are shown
+    if (event->wd == presets_inotify_wd && (event->mask & IN_IGNORED)) {
+      if (presets_inotify_add_watch() < 0) {
+        close(presets_inotify_fd);
+        presets_inotify_fd = -1;
+        preset_indexes_scan();
+        return FALSE;
+      }
+
+      if (debug_enabled("presets"))
+        printf("PRESETS: presets directory replaced; rescanning\n");
+
+      preset_indexes_scan();
+      continue;
+    }
+
+    g_hash_table_iter_init(&iter, preset_indexes);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer *)&index)) {
+
+      // events were lost; start again
+      if (event->mask & IN_Q_OVERFLOW) {
+        preset_index_scan(index);
+        continue;
+      }
+
+      if (!event->len)
+        continue;
+
+      char *name = get_preset_name(index->serial, event->name);
+      if (!name)
+        continue;
+
+      preset_index_update(
+        index, name, !(event->mask & (IN_DELETE | IN_MOVED_FROM))
+      );
+      g_free(name);
+    }
+  }
+
+  return TRUE;
+}
+
+static void presets_inotify_init(void) {
+  presets_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (presets_inotify_fd < 0) {
+    perror("presets inotify_init");
+    return;
+  }
+
+  if (presets_inotify_add_watch() < 0) {
+    close(presets_inotify_fd);
+    presets_inotify_fd = -1;
+    return;
+  }
+
+  GIOChannel *io_channel = g_io_channel_unix_new(presets_inotify_fd);
+  g_io_add_watch_full(
+    io_channel, 0,
+    G_IO_IN | G_IO_ERR | G_IO_HUP,
+    presets_inotify_callback, NULL, NULL
+  );
+  g_io_channel_unref(io_channel);
+}
+
+// Get the index for a serial, starting its scan if it's new
+static struct preset_index *get_preset_index(const char *serial) {
+  if (!preset_indexes) {
+    preset_indexes = g_hash_table_new(g_str_hash, g_str_equal);
+    presets_inotify_init();
+  }
+
+  struct preset_index *index = g_hash_table_lookup(preset_indexes, serial);
+  if (index)
+    return index;
+
+  index = g_malloc0(sizeof(struct preset_index));
+  index->serial = g_strdup(serial);
+  g_hash_table_insert(preset_indexes, index->serial, index);
+
+  preset_index_scan(index);
+
+  return index;
+}
+
+// Each Presets button reads its card's presets on a worker thread,
+// one at a time, as the index changes; the results are resolved to
+// the card's elements at low priority on the main thread, so loading
+// a preset only has to apply it
+
+static void prefetch_next(struct presets_data *data);
+
+struct prefetch_job {
+  char                      *path;
+  struct native_snapshot_id  id;
+};
+
+static void free_prefetch_job(gpointer user_data) {
+  struct prefetch_job *job = user_data;
+
+  g_free(job->path);
+  native_snapshot_id_clear(&job->id);
+  g_free(job);
+}
+
+static void prefetch_thread(
+  GTask        *task,
+  gpointer      source_object,
+  gpointer      task_data,
+  GCancellable *cancellable
+) {
+  struct prefetch_job *job = task_data;
+
+  g_task_return_pointer(
+    task, native_config_read(job->path, &job->id),
+    (GDestroyNotify)native_config_free
+  );
+}
+
+static void prefetch_done(
+  GObject      *source_object,
+  GAsyncResult *result,
+  gpointer      user_data
+) {
+
+  // the button has been destroyed
+  if (g_cancellable_is_cancelled(g_task_get_cancellable(G_TASK(result))))
+    return;
+
+  struct presets_data *data = user_data;
+  struct native_config *config = g_task_propagate_pointer(
+    G_TASK(result), NULL
+  );
+  char *name = data->prefetching;
+
+  data->prefetching = NULL;
+
+  // read again if the file changed while it was being read
+  if (data->prefetch_stale) {
+    native_config_free(config);
+    g_free(name);
+  } else {
+    if (config)
+      native_config_resolve(data->card, config);
+    g_hash_table_replace(data->prefetched, name, config);
+
+    if (debug_enabled("presets"))
+      printf(
+        "PRESETS: prefetched \"%s\"%s\n",
+        name, config ? "" : " (unreadable)"
+      );
+  }
+
+  prefetch_next(data);
+}
 
-  if (load_native(card, path) < 0) {
+// Start reading the next preset which hasn't been prefetched
+static void prefetch_next(struct presets_data *data) {
+  if (data->prefetching)
+    return;
+
+  for (GList *l = data->index->names; l; l = l->next) {
+    const char *name = l->data;
+
+    if (g_hash_table_contains(data->prefetched, name))
+      continue;
+
+    struct prefetch_job *job = g_malloc0(sizeof(struct prefetch_job));
+    job->path = get_preset_path(data->card->serial, name);
+    native_snapshot_id_init(data->card, &job->id);
+
+    data->prefetching = g_strdup(name);
+    data->prefetch_stale = FALSE;
+
+    GTask *task = g_task_new(
+      NULL, data->prefetch_cancellable, prefetch_done, data
+    );
+    g_task_set_priority(task, G_PRIORITY_LOW);
+    g_task_set_task_data(task, job, free_prefetch_job);
+    g_task_run_in_thread(task, prefetch_thread);
+    g_object_unref(task);
+
+    return;
+  }
+}
+
+// Drop the prefetched preset (or all of them if name is NULL) and
+// read what's missing
+static void prefetch_invalidate(struct presets_data *data, const char *name) {
+  if (name)
+    g_hash_table_remove(data->prefetched, name);
+  else
+    g_hash_table_remove_all(data->prefetched);
+
+  if (data->prefetching && (!name || !strcmp(name, data->prefetching)))
+    data->prefetch_stale = TRUE;
+
+  prefetch_next(data);
+}
+
+// Load a preset, from the prefetched copy if there is one
+static void load_preset(struct presets_data *data, const char *name) {
+  struct alsa_card *card = data->card;
+  struct native_config *config = g_hash_table_lookup(data->prefetched, name);
+  struct load_native_stats stats;
+  int ret = 0;
+
+  if (config) {
+    native_config_apply(card, config, &stats);
+  } else {
+    char *path = get_preset_path(card->serial, name);
+    ret = load_native(card, path, &stats);
+    g_free(path);
+  }
+
+  if (ret < 0) {
     char *msg = g_strdup_printf("Error loading preset \"%s\"", name);
     show_error(GTK_WINDOW(card->window_main), msg);
     g_free(msg);
+  } else if (debug_enabled("presets")) {
+    printf(
+      "PRESETS: loaded \"%s\" (%s): %d compared, %d changed, "
+        "%d skipped in %.1f ms\n",
+      name, config ? "prefetched" : "read",
+      stats.compared, stats.changed, stats.skipped, stats.elapsed_ms
+    );
   }
-
-  g_free(path);
 }
 
 // Save a preset
@@ -117,22 +568,21 @@ static int save_preset(struct alsa_card *card, const char *name) {
     return -1;
 
   char *path = get_preset_path(card->serial, name);
-  int ret = save_native(card, path);
 
-  if (ret < 0) {
-    char *msg = g_strdup_printf("Error saving preset \"%s\"", name);
-    show_error(GTK_WINDOW(card->window_main), msg);
-    g_free(msg);
-  }
+  save_native_with_snapshot(card, path);
 
   g_free(path);
-  return ret;
+  return 0;
 }
 
-// Delete a preset
+// Delete a preset and its snapshot
 static int delete_preset(const char *serial, const char *name) {
   char *path = get_preset_path(serial, name);
+  char *snapshot_path = native_snapshot_path(path);
   int ret = g_unlink(path);
+
+  g_unlink(snapshot_path);
+  g_free(snapshot_path);
   g_free(path);
   return ret;
 }
@@ -325,7 +775,7 @@ static void preset_row_clicked(
   if (on_delete)
     delete_preset(data->card->serial, name);
   else
-    load_preset(data->card, name);
+    load_preset(data, name);
 
   gtk_popover_popdown(GTK_POPOVER(data->popover));
 }
@@ -336,7 +786,7 @@ static void preset_row_activated(GtkButton *button, gpointer user_data) {
   const char *name = g_object_get_data(G_OBJECT(button), "preset-name");
 
   if (name) {
-    load_preset(data->card, name);
+    load_preset(data, name);
     gtk_popover_popdown(GTK_POPOVER(data->popover));
   }
 }
@@ -401,19 +851,17 @@ static void populate_presets_list(struct presets_data *data) {
   while ((child = gtk_widget_get_first_child(data->box)) != NULL)
     gtk_box_remove(GTK_BOX(data->box), child);
 
-  // Scan for presets
-  GList *presets = scan_presets(data->card->serial);
+  GList *presets = data->index->names;
   int has_presets = presets != NULL;
 
+  data->generation = data->index->generation;
+
   // Add preset rows
   for (GList *l = presets; l; l = l->next) {
     GtkWidget *row = create_preset_row(data, l->data);
     gtk_box_append(GTK_BOX(data->box), row);
   }
 
-  // Free the list
-  g_list_free_full(presets, g_free);
-
   // Add separator if there were presets
   if (has_presets) {
     GtkWidget *sep = gtk_separator_new(GTK_ORIENTATION_HORIZONTAL);
@@ -426,15 +874,31 @@ static void populate_presets_list(struct presets_data *data) {
   gtk_box_append(GTK_BOX(data->box), save_btn);
 }
 
-// Callback when popover is shown - refresh the preset list
+// Callback when popover is shown - refresh the preset list if the
+// index has changed since it was last populated
 static void popover_show(GtkWidget *popover, gpointer user_data) {
   struct presets_data *data = user_data;
-  populate_presets_list(data);
+
+  // not watching the directory; the list is refreshed again when the
+  // scan finishes
+  if (presets_inotify_fd < 0)
+    preset_index_scan(data->index);
+
+  if (data->generation != data->index->generation)
+    populate_presets_list(data);
 }
 
 // Free presets data
 static void free_presets_data(gpointer user_data) {
-  g_free(user_data);
+  struct presets_data *data = user_data;
+
+  data->index->listeners = g_list_remove(data->index->listeners, data);
+
+  g_cancellable_cancel(data->prefetch_cancellable);
+  g_object_unref(data->prefetch_cancellable);
+  g_hash_table_destroy(data->prefetched);
+  g_free(data->prefetching);
+  g_free(data);
 }
 
 // Save initial configuration on first-ever load of a real interface
@@ -464,6 +928,15 @@ void save_initial_config(struct alsa_card *card) {
 GtkWidget *create_presets_button(struct alsa_card *card) {
   struct presets_data *data = g_malloc0(sizeof(struct presets_data));
   data->card = card;
+  data->index = get_preset_index(card->serial);
+  data->generation = data->index->generation - 1;
+  data->index->listeners = g_list_prepend(data->index->listeners, data);
+
+  data->prefetched = g_hash_table_new_full(
+    g_str_hash, g_str_equal, g_free, (GDestroyNotify)native_config_free
+  );
+  data->prefetch_cancellable = g_cancellable_new();
+  prefetch_next(data);
 
   // Create menu button
   GtkWidget *button = gtk_menu_button_new();
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "routing-graph.h"
+
+static struct routing_src *get_src(struct alsa_card *card, int src_idx) {
+  if (src_idx < 0 || src_idx >= card->routing_srcs->len)
+    return NULL;
+
+  return &g_array_index(card->routing_srcs, struct routing_src, src_idx);
+}
+
+static struct routing_snk *get_snk(struct alsa_card *card, int snk_idx) {
+  if (snk_idx < 0)
+    return NULL;
+
+  return &g_array_index(card->routing_snks, struct routing_snk, snk_idx);
+}
+
+// add a sink to the front of its effective source's list
+static void link_snk(struct alsa_card *card, struct routing_snk *r_snk) {
+  struct routing_src *r_src = get_src(card, r_snk->effective_source_idx);
+
+  r_snk->prev_snk_idx = -1;
+  r_snk->next_snk_idx = -1;
+
+  if (!r_src)
+    return;
+
+  struct routing_snk *head = get_snk(card, r_src->first_snk_idx);
+  if (head)
+    head->prev_snk_idx = r_snk->idx;
+
+  r_snk->next_snk_idx = r_src->first_snk_idx;
+  r_src->first_snk_idx = r_snk->idx;
+  r_src->snk_count++;
+}
+
+// remove a sink from its effective source's list
+static void unlink_snk(struct alsa_card *card, struct routing_snk *r_snk) {
+  struct routing_src *r_src = get_src(card, r_snk->effective_source_idx);
+
+  if (!r_src)
+    return;
+
+  struct routing_snk *prev = get_snk(card, r_snk->prev_snk_idx);
+  struct routing_snk *next = get_snk(card, r_snk->next_snk_idx);
+
+  if (prev)
+    prev->next_snk_idx = r_snk->next_snk_idx;
+  else
+    r_src->first_snk_idx = r_snk->next_snk_idx;
+
+  if (next)
+    next->prev_snk_idx = r_snk->prev_snk_idx;
+
+  r_snk->prev_snk_idx = -1;
+  r_snk->next_snk_idx = -1;
+  r_src->snk_count--;
+}
+
+void routing_graph_rebuild(struct alsa_card *card) {
+  if (!card->routing_srcs || !card->routing_snks)
+    return;
+
+  for (int i = 0; i < card->routing_srcs->len; i++) {
+    struct routing_src *r_src = get_src(card, i);
+
+    r_src->first_snk_idx = -1;
+    r_src->snk_count = 0;
+  }
+
+  // link in reverse so each list is in sink order
+  for (int i = card->routing_snks->len - 1; i >= 0; i--)
+    link_snk(card, get_snk(card, i));
+}
+
+int routing_graph_set_snk_src(struct routing_snk *r_snk, int src_idx) {
+  struct alsa_card *card = r_snk->elem->card;
+
+  if (r_snk->effective_source_idx == src_idx)
+    return 0;
+
+  unlink_snk(card, r_snk);
+  r_snk->effective_source_idx = src_idx;
+  link_snk(card, r_snk);
+
+  return 1;
+}
+
+struct routing_snk *routing_graph_first_snk(
+  struct alsa_card   *card,
+  struct routing_src *r_src
+) {
+  return get_snk(card, r_src->first_snk_idx);
+}
+
+struct routing_snk *routing_graph_next_snk(
+  struct alsa_card   *card,
+  struct routing_snk *r_snk
+) {
+  return get_snk(card, r_snk->next_snk_idx);
+}
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "alsa.h"
+
+// Source → sinks adjacency index over the routing sinks' effective
+// sources. Each source keeps a list of the sinks connected to it,
+// linked through the sinks themselves, so connections can be
+// queried in O(degree) without scanning or allocating.
+
+// Rebuild the index from every sink's effective_source_idx
+void routing_graph_rebuild(struct alsa_card *card);
+
+// Set a sink's effective source, moving it to the new source's list
+// Returns true if the effective source changed
+int routing_graph_set_snk_src(struct routing_snk *r_snk, int src_idx);
+
+// Iterate over the sinks connected to a source:
+//   for (r_snk = routing_graph_first_snk(card, r_src); r_snk;
+//        r_snk = routing_graph_next_snk(card, r_snk))
+struct routing_snk *routing_graph_first_snk(
+  struct alsa_card   *card,
+  struct routing_src *r_src
+);
+struct routing_snk *routing_graph_next_snk(
+  struct alsa_card   *card,
+  struct routing_snk *r_snk
+);
@@ -4,7 +4,9 @@
 #include <graphene.h>
 
 #include "alsa.h"
+#include "debug.h"
 #include "glow.h"
+#include "routing-graph.h"
 #include "routing-lines.h"
 #include "port-enable.h"
 #include "stereo-link.h"
@@ -474,15 +476,49 @@ static void get_snk_center(
     (*y)++;
 }
 
-// redraw the overlay lines between the routing sources and sinks
-void draw_routing_lines(
-  GtkDrawingArea *drawing_area,
-  cairo_t        *cr,
-  int             width,
-  int             height,
-  void           *user_data
+// check if a source has a connection that gets a routing line: to
+// an enabled sink that isn't a read-only mixer input
+static int has_drawn_connection(
+  struct alsa_card   *card,
+  struct routing_src *r_src
 ) {
-  struct alsa_card *card = user_data;
+  for (struct routing_snk *r_snk = routing_graph_first_snk(card, r_src);
+       r_snk;
+       r_snk = routing_graph_next_snk(card, r_snk)) {
+    struct alsa_elem *elem = r_snk->elem;
+
+    if (elem->port_category == PC_MIX && card->has_fixed_mixer_inputs)
+      continue;
+
+    if (is_routing_snk_enabled(r_snk))
+      return 1;
+  }
+
+  return 0;
+}
+
+// check if a source has a connection to a disabled sink (other than
+// a read-only mixer input)
+static int has_disabled_connection(
+  struct alsa_card   *card,
+  struct routing_src *r_src
+) {
+  for (struct routing_snk *r_snk = routing_graph_first_snk(card, r_src);
+       r_snk;
+       r_snk = routing_graph_next_snk(card, r_snk)) {
+    struct alsa_elem *elem = r_snk->elem;
+
+    if (elem->port_category == PC_MIX && card->has_fixed_mixer_inputs)
+      continue;
+
+    if (!is_routing_snk_enabled(r_snk))
+      return 1;
+  }
+
+  return 0;
+}
+
+static void render_routing_lines(struct alsa_card *card, cairo_t *cr) {
   GtkWidget *parent = card->routing_lines;
 
   cairo_set_line_cap(cr, CAIRO_LINE_CAP_ROUND);
@@ -544,40 +580,9 @@ void draw_routing_lines(
       );
     }
 
-    // draw glows for unconnected sources that have level meters
-    // first, track which sources have at least one enabled connection
-    int *src_connected = g_malloc0(card->routing_srcs->len * sizeof(int));
-
-    for (int i = 0; i < card->routing_snks->len; i++) {
-      struct routing_snk *r_snk = &g_array_index(
-        card->routing_snks, struct routing_snk, i
-      );
-      struct alsa_elem *elem = r_snk->elem;
-
-      // skip read-only mixer sinks
-      if (elem->port_category == PC_MIX && card->has_fixed_mixer_inputs)
-        continue;
-
-      // skip disabled sinks
-      if (!is_routing_snk_enabled(r_snk))
-        continue;
-
-      int r_src_idx = r_snk->effective_source_idx;
-      if (r_src_idx > 0 && r_src_idx < card->routing_srcs->len) {
-        struct routing_src *r_src = &g_array_index(
-          card->routing_srcs, struct routing_src, r_src_idx
-        );
-        // only mark as connected if source is enabled
-        if (is_routing_src_enabled(r_src))
-          src_connected[r_src_idx] = 1;
-      }
-    }
-
-    // now draw glows for unconnected sources
+    // draw glows for enabled sources that have level meters but no
+    // drawn connection
     for (int i = 1; i < card->routing_srcs->len; i++) {
-      if (src_connected[i])
-        continue;
-
       struct routing_src *r_src = &g_array_index(
         card->routing_srcs, struct routing_src, i
       );
@@ -586,6 +591,9 @@ void draw_routing_lines(
       if (!is_routing_src_enabled(r_src))
         continue;
 
+      if (has_drawn_connection(card, r_src))
+        continue;
+
       // skip if no widget
       if (!r_src->widget2)
         continue;
@@ -598,8 +606,6 @@ void draw_routing_lines(
       get_src_center(r_src, parent, &x, &y);
       draw_source_glow(cr, x, y, level_db);
     }
-
-    g_free(src_connected);
   }
 
   // second pass: draw the routing lines on top
@@ -671,12 +677,7 @@ void draw_routing_lines(
   // draw arrows for connections to/from disabled ports
   // this shows the user that something is connected but hidden
 
-  // track which sources have connections to disabled sinks
-  // (use a simple array since source IDs are small integers)
-  int *src_has_disabled_snk = g_malloc0(card->routing_srcs->len * sizeof(int));
-
   // first pass: find enabled sinks connected to disabled sources
-  // and disabled sinks (to mark their sources)
   for (int i = 0; i < card->routing_snks->len; i++) {
     struct routing_snk *r_snk = &g_array_index(
       card->routing_snks, struct routing_snk, i
@@ -710,18 +711,11 @@ void draw_routing_lines(
       double level_db = get_routing_src_level_db(card, r_src);
       draw_arrow_indicator(cr, x, y, direction, 0.75, 0.25, 0.25, level_db);
     }
-
-    // case 2: disabled sink → mark the source
-    if (!snk_enabled && src_enabled) {
-      src_has_disabled_snk[r_src_idx] = 1;
-    }
   }
 
-  // second pass: draw arrows from sources that have disabled sinks
+  // second pass: draw arrows from enabled sources connected to
+  // disabled sinks, found through the adjacency index
   for (int i = 1; i < card->routing_srcs->len; i++) {
-    if (!src_has_disabled_snk[i])
-      continue;
-
     struct routing_src *r_src = &g_array_index(
       card->routing_srcs, struct routing_src, i
     );
@@ -730,6 +724,9 @@ void draw_routing_lines(
     if (!is_routing_src_enabled(r_src))
       continue;
 
+    if (!has_disabled_connection(card, r_src))
+      continue;
+
     double x, y;
     get_src_center(r_src, parent, &x, &y);
 
@@ -739,8 +736,330 @@ void draw_routing_lines(
     double level_db = get_routing_src_level_db(card, r_src);
     draw_arrow_indicator(cr, x, y, direction, 0.75, 0.25, 0.25, level_db);
   }
+}
+
+// padding around a connection's bounding box to cover the glow
+// width and the arrow in the middle of the line
+#define DAMAGE_LINE_PAD (GLOW_MAX_WIDTH / 2 + 14)
+
+// padding around a port to cover the source glow and the arrow
+// indicators for connections to/from disabled ports
+#define DAMAGE_PORT_PAD (36 + GLOW_MAX_WIDTH / 2 + 2)
+
+// region of the routing lines canvas whose glow depends on the level
+// of one routing source
+struct glow_item {
+  int                   src_idx;
+  cairo_rectangle_int_t rect;
+};
+
+// backing store for the routing lines so that level updates only
+// re-rasterise the connections whose glow changed
+struct routing_lines_cache {
+
+  // the last rendered routing lines
+  cairo_surface_t *surface;
+  int              width;
+  int              height;
+  int              scale;
+
+  // geometry of the last render; any change needs a full redraw
+  GArray          *layout;
+  GArray          *next_layout;
+
+  // glow regions of the last render
+  GArray          *items;
+
+  // glow bucket of each routing source in the surface, and scratch
+  // space for the current buckets
+  int             *drawn_buckets;
+  int             *buckets;
+};
+
+static struct routing_lines_cache *get_routing_lines_cache(
+  struct alsa_card *card
+) {
+  struct routing_lines_cache *cache = card->routing_lines_cache;
+
+  if (cache)
+    return cache;
+
+  cache = g_malloc0(sizeof(struct routing_lines_cache));
+  cache->layout = g_array_new(FALSE, FALSE, sizeof(double));
+  cache->next_layout = g_array_new(FALSE, FALSE, sizeof(double));
+  cache->items = g_array_new(FALSE, FALSE, sizeof(struct glow_item));
+  cache->drawn_buckets = g_malloc0(card->routing_srcs->len * sizeof(int));
+  cache->buckets = g_malloc0(card->routing_srcs->len * sizeof(int));
+
+  card->routing_lines_cache = cache;
+
+  return cache;
+}
+
+static void routing_lines_cache_free(struct alsa_card *card) {
+  struct routing_lines_cache *cache = card->routing_lines_cache;
+
+  if (!cache)
+    return;
+
+  if (cache->surface)
+    cairo_surface_destroy(cache->surface);
+  g_array_free(cache->layout, TRUE);
+  g_array_free(cache->next_layout, TRUE);
+  g_array_free(cache->items, TRUE);
+  g_free(cache->drawn_buckets);
+  g_free(cache->buckets);
+  g_free(cache);
 
-  g_free(src_has_disabled_snk);
+  card->routing_lines_cache = NULL;
+}
+
+static void layout_add(GArray *layout, double value) {
+  g_array_append_val(layout, value);
+}
+
+static void add_glow_item(
+  GArray *items,
+  int     src_idx,
+  double  x1,
+  double  y1,
+  double  x2,
+  double  y2,
+  double  pad
+) {
+  struct glow_item item = { .src_idx = src_idx };
+
+  item.rect.x = floor(fmin(x1, x2) - pad);
+  item.rect.y = floor(fmin(y1, y2) - pad);
+  item.rect.width = ceil(fmax(x1, x2) + pad) - item.rect.x;
+  item.rect.height = ceil(fmax(y1, y2) + pad) - item.rect.y;
+
+  g_array_append_val(items, item);
+}
+
+// record the geometry that render_routing_lines() depends on, and
+// the region of each glow that a level change would affect
+static void collect_routing_lines_layout(
+  struct alsa_card           *card,
+  struct routing_lines_cache *cache,
+  int                         width,
+  int                         height,
+  int                         scale
+) {
+  GtkWidget *parent = card->routing_lines;
+  GArray *layout = cache->next_layout;
+  GArray *items = cache->items;
+
+  g_array_set_size(layout, 0);
+  g_array_set_size(items, 0);
+
+  int dragging = card->drag_type != DRAG_TYPE_NONE;
+
+  layout_add(layout, width);
+  layout_add(layout, height);
+  layout_add(layout, scale);
+  layout_add(layout, dragging);
+  layout_add(layout, card->snk_drag ? card->snk_drag->idx : -1);
+
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+
+    if (r_snk->elem->port_category == PC_MIX &&
+        card->has_fixed_mixer_inputs)
+      continue;
+
+    int r_src_idx = r_snk->effective_source_idx;
+
+    layout_add(layout, is_routing_snk_enabled(r_snk));
+    layout_add(layout, r_src_idx);
+
+    if (!r_src_idx)
+      continue;
+
+    struct routing_src *r_src = &g_array_index(
+      card->routing_srcs, struct routing_src, r_src_idx
+    );
+
+    double x1, y1, x2, y2;
+    get_src_center(r_src, parent, &x1, &y1);
+    get_snk_center(r_snk, parent, &x2, &y2);
+
+    layout_add(layout, is_routing_src_enabled(r_src));
+    layout_add(layout, x1);
+    layout_add(layout, y1);
+    layout_add(layout, x2);
+    layout_add(layout, y2);
+
+    add_glow_item(items, r_src_idx, x1, y1, x2, y2, DAMAGE_LINE_PAD);
+    add_glow_item(items, r_src_idx, x2, y2, x2, y2, DAMAGE_PORT_PAD);
+  }
+
+  for (int i = 1; i < card->routing_srcs->len; i++) {
+    struct routing_src *r_src = &g_array_index(
+      card->routing_srcs, struct routing_src, i
+    );
+
+    if (!r_src->widget2)
+      continue;
+
+    double x, y;
+    get_src_center(r_src, parent, &x, &y);
+
+    layout_add(layout, is_routing_src_enabled(r_src));
+    layout_add(layout, x);
+    layout_add(layout, y);
+
+    add_glow_item(items, i, x, y, x, y, DAMAGE_PORT_PAD);
+  }
+}
+
+// outline the damaged rectangles (ALSA_SCARLETT_GUI_DEBUG=routing-damage)
+static void draw_damage_overlay(cairo_t *cr, cairo_region_t *damage) {
+  int n = cairo_region_num_rectangles(damage);
+
+  cairo_save(cr);
+  cairo_set_dash(cr, NULL, 0, 0);
+  cairo_set_line_width(cr, 1);
+
+  for (int i = 0; i < n; i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(damage, i, &rect);
+
+    cairo_rectangle(cr, rect.x, rect.y, rect.width, rect.height);
+    cairo_set_source_rgba(cr, 1, 0, 1, 0.15);
+    cairo_fill_preserve(cr);
+    cairo_set_source_rgba(cr, 1, 0, 1, 0.8);
+    cairo_stroke(cr);
+  }
+
+  cairo_restore(cr);
+}
+
+// redraw the overlay lines between the routing sources and sinks
+//
+// The lines are rendered into a backing surface. If the geometry is
+// unchanged since the last render, only the regions of glows whose
+// level bucket changed are cleared and re-rendered.
+void draw_routing_lines(
+  GtkDrawingArea *drawing_area,
+  cairo_t        *cr,
+  int             width,
+  int             height,
+  void           *user_data
+) {
+  struct alsa_card *card = user_data;
+  struct routing_lines_cache *cache = get_routing_lines_cache(card);
+  int scale = gtk_widget_get_scale_factor(card->routing_lines);
+
+  collect_routing_lines_layout(card, cache, width, height, scale);
+
+  int src_count = card->routing_srcs->len;
+  int *buckets = cache->buckets;
+  for (int i = 0; i < src_count; i++) {
+    struct routing_src *r_src = &g_array_index(
+      card->routing_srcs, struct routing_src, i
+    );
+    buckets[i] = card->routing_levels
+      ? get_glow_bucket(get_routing_src_level_db(card, r_src))
+      : 0;
+  }
+
+  int full = !cache->surface ||
+             cache->layout->len != cache->next_layout->len ||
+             memcmp(
+               cache->layout->data,
+               cache->next_layout->data,
+               cache->layout->len * sizeof(double)
+             ) != 0;
+
+  if (full && cache->surface &&
+      (cache->width != width ||
+       cache->height != height ||
+       cache->scale != scale)) {
+    cairo_surface_destroy(cache->surface);
+    cache->surface = NULL;
+  }
+
+  if (!cache->surface) {
+    cache->surface = cairo_image_surface_create(
+      CAIRO_FORMAT_ARGB32, width * scale, height * scale
+    );
+    cairo_surface_set_device_scale(cache->surface, scale, scale);
+    cache->width = width;
+    cache->height = height;
+    cache->scale = scale;
+  }
+
+  cairo_region_t *damage;
+
+  if (full) {
+    cairo_rectangle_int_t all = { 0, 0, width, height };
+    damage = cairo_region_create_rectangle(&all);
+  } else {
+    damage = cairo_region_create();
+
+    for (int i = 0; i < cache->items->len; i++) {
+      struct glow_item *item = &g_array_index(
+        cache->items, struct glow_item, i
+      );
+
+      if (buckets[item->src_idx] != cache->drawn_buckets[item->src_idx])
+        cairo_region_union_rectangle(damage, &item->rect);
+    }
+  }
+
+  if (!cairo_region_is_empty(damage)) {
+    cairo_t *scr = cairo_create(cache->surface);
+
+    gdk_cairo_region(scr, damage);
+    cairo_clip(scr);
+
+    cairo_set_operator(scr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(scr);
+    cairo_set_operator(scr, CAIRO_OPERATOR_OVER);
+
+    render_routing_lines(card, scr);
+    cairo_destroy(scr);
+  }
+
+  cairo_set_source_surface(cr, cache->surface, 0, 0);
+  cairo_paint(cr);
+
+  if (debug_enabled("routing-damage"))
+    draw_damage_overlay(cr, damage);
+
+  cairo_region_destroy(damage);
+
+  GArray *tmp = cache->layout;
+  cache->layout = cache->next_layout;
+  cache->next_layout = tmp;
+
+  memcpy(cache->drawn_buckets, buckets, src_count * sizeof(int));
+}
+
+// called by the levels timer after card->routing_levels has been
+// updated; only queue a redraw if a routing source's glow changed
+void routing_lines_levels_updated(struct alsa_card *card) {
+  struct routing_lines_cache *cache = card->routing_lines_cache;
+
+  if (!cache || !cache->surface) {
+    gtk_widget_queue_draw(card->routing_lines);
+    return;
+  }
+
+  for (int i = 0; i < card->routing_srcs->len; i++) {
+    struct routing_src *r_src = &g_array_index(
+      card->routing_srcs, struct routing_src, i
+    );
+
+    if (get_glow_bucket(get_routing_src_level_db(card, r_src)) !=
+          cache->drawn_buckets[i]) {
+      gtk_widget_queue_draw(card->routing_lines);
+      return;
+    }
+  }
 }
 
 // Get stereo source L and R positions
@@ -975,4 +1294,6 @@ void routing_levels_cleanup(struct alsa_card *card) {
 
   card->routing_levels_count = 0;
   card->level_meter_elem = NULL;
+
+  routing_lines_cache_free(card);
 }
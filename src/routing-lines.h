@@ -24,4 +24,5 @@ void draw_drag_line(
 
 // level indication for routing lines
 void routing_levels_init(struct alsa_card *card);
+void routing_lines_levels_updated(struct alsa_card *card);
 void routing_levels_cleanup(struct alsa_card *card);
@@ -0,0 +1,347 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <stdio.h>
+
+#include "debug.h"
+#include "port-enable.h"
+#include "snapshot-history.h"
+
+// number of snapshots kept; the oldest is dropped when full
+#define SNAPSHOT_HISTORY_SIZE 100
+
+// changes within this time of the first one make up one snapshot
+#define SNAPSHOT_CAPTURE_DELAY_MS 300
+
+// one changed sink (value = source) or mixer cell (value = gain)
+struct snapshot_change {
+  int slot;
+  int old_value;
+  int new_value;
+};
+
+// the changes from the previous state to this one
+struct snapshot {
+  struct snapshot_change *changes;
+  int                     count;
+};
+
+// a tracked routing sink or mixer gain element
+struct snapshot_slot {
+  struct snapshot_history *history;
+  struct alsa_elem        *elem;
+
+  // value in the current history state
+  int                      value;
+
+  // changed since the last capture
+  int                      dirty;
+};
+
+struct snapshot_history {
+  struct alsa_card     *card;
+
+  // routing sinks first, then mixer cells
+  struct snapshot_slot *slots;
+  int                   slot_count;
+
+  // slots changed since the last capture
+  int                  *dirty_slots;
+  int                   dirty_count;
+  guint                 capture_timer;
+
+  // ring of snapshots; entry i takes state i to state i + 1
+  struct snapshot       ring[SNAPSHOT_HISTORY_SIZE];
+  int                   head;
+  int                   count;
+
+  // current state (0 .. count) and A/B mark (-1 if none)
+  int                   cursor;
+  int                   mark;
+};
+
+static struct snapshot *get_snapshot(struct snapshot_history *history, int i) {
+  return &history->ring[(history->head + i) % SNAPSHOT_HISTORY_SIZE];
+}
+
+static void free_snapshot(struct snapshot *snapshot) {
+  g_free(snapshot->changes);
+  snapshot->changes = NULL;
+  snapshot->count = 0;
+}
+
+// add a snapshot after the current state, discarding any redo states
+static void push_snapshot(
+  struct snapshot_history *history,
+  struct snapshot_change  *changes,
+  int                      count
+) {
+  while (history->count > history->cursor)
+    free_snapshot(get_snapshot(history, --history->count));
+
+  if (history->mark > history->cursor)
+    history->mark = -1;
+
+  // drop the oldest snapshot if the ring is full
+  if (history->count == SNAPSHOT_HISTORY_SIZE) {
+    free_snapshot(get_snapshot(history, 0));
+    history->head = (history->head + 1) % SNAPSHOT_HISTORY_SIZE;
+    history->count--;
+    history->cursor--;
+    if (history->mark >= 0)
+      history->mark--;
+  }
+
+  struct snapshot *snapshot = get_snapshot(history, history->count);
+
+  snapshot->changes = changes;
+  snapshot->count = count;
+
+  history->count++;
+  history->cursor++;
+}
+
+// store the changed slots as a new snapshot
+static void capture_snapshot(struct snapshot_history *history) {
+  if (history->capture_timer) {
+    g_source_remove(history->capture_timer);
+    history->capture_timer = 0;
+  }
+
+  if (!history->dirty_count)
+    return;
+
+  struct snapshot_change *changes = g_malloc(
+    history->dirty_count * sizeof(struct snapshot_change)
+  );
+  int count = 0;
+
+  for (int i = 0; i < history->dirty_count; i++) {
+    int idx = history->dirty_slots[i];
+    struct snapshot_slot *slot = &history->slots[idx];
+    int value = alsa_get_elem_value(slot->elem);
+
+    slot->dirty = 0;
+
+    if (value == slot->value)
+      continue;
+
+    changes[count].slot = idx;
+    changes[count].old_value = slot->value;
+    changes[count].new_value = value;
+    count++;
+
+    slot->value = value;
+  }
+
+  history->dirty_count = 0;
+
+  if (!count) {
+    g_free(changes);
+    return;
+  }
+
+  push_snapshot(history, changes, count);
+
+  if (debug_enabled("snapshot"))
+    printf(
+      "SNAPSHOT: stored %d changes, %d of %d snapshots\n",
+      count, history->cursor, history->count
+    );
+}
+
+static gboolean capture_timeout(gpointer user_data) {
+  struct snapshot_history *history = user_data;
+
+  history->capture_timer = 0;
+  capture_snapshot(history);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void slot_elem_changed(struct alsa_elem *elem, void *private) {
+  struct snapshot_slot *slot = private;
+  struct snapshot_history *history = slot->history;
+
+  if (!slot->dirty) {
+    slot->dirty = 1;
+    history->dirty_slots[history->dirty_count++] = slot - history->slots;
+  }
+
+  if (!history->capture_timer)
+    history->capture_timer = g_timeout_add(
+      SNAPSHOT_CAPTURE_DELAY_MS, capture_timeout, history
+    );
+}
+
+// move to another state in the history, writing only the elements
+// whose value differs
+static void restore_state(struct snapshot_history *history, int target) {
+  struct alsa_card *card = history->card;
+  char *touched = g_malloc0(history->slot_count);
+
+  while (history->cursor > target) {
+    struct snapshot *snapshot = get_snapshot(history, --history->cursor);
+
+    for (int i = snapshot->count - 1; i >= 0; i--) {
+      struct snapshot_change *change = &snapshot->changes[i];
+
+      history->slots[change->slot].value = change->old_value;
+      touched[change->slot] = 1;
+    }
+  }
+
+  while (history->cursor < target) {
+    struct snapshot *snapshot = get_snapshot(history, history->cursor++);
+
+    for (int i = 0; i < snapshot->count; i++) {
+      struct snapshot_change *change = &snapshot->changes[i];
+
+      history->slots[change->slot].value = change->new_value;
+      touched[change->slot] = 1;
+    }
+  }
+
+  // defer the routing UI updates to one update at idle
+  card->routing_ui_update_deferred = TRUE;
+
+  int written = 0;
+  int skipped = 0;
+
+  for (int i = 0; i < history->slot_count; i++) {
+    if (!touched[i])
+      continue;
+
+    struct snapshot_slot *slot = &history->slots[i];
+
+    if (alsa_get_elem_value(slot->elem) == slot->value) {
+      skipped++;
+      continue;
+    }
+
+    alsa_set_elem_value(slot->elem, slot->value);
+    written++;
+  }
+
+  schedule_ui_update(card, PENDING_UI_UPDATE_ROUTING);
+  g_free(touched);
+
+  if (debug_enabled("snapshot"))
+    printf(
+      "SNAPSHOT: restored %d of %d snapshots, %d written, %d skipped\n",
+      history->cursor, history->count, written, skipped
+    );
+}
+
+void snapshot_history_undo(struct alsa_card *card) {
+  struct snapshot_history *history = card->snapshot_history;
+
+  if (!history)
+    return;
+
+  capture_snapshot(history);
+
+  if (history->cursor > 0)
+    restore_state(history, history->cursor - 1);
+}
+
+void snapshot_history_redo(struct alsa_card *card) {
+  struct snapshot_history *history = card->snapshot_history;
+
+  if (!history)
+    return;
+
+  capture_snapshot(history);
+
+  if (history->cursor < history->count)
+    restore_state(history, history->cursor + 1);
+}
+
+void snapshot_history_mark(struct alsa_card *card) {
+  struct snapshot_history *history = card->snapshot_history;
+
+  if (!history)
+    return;
+
+  capture_snapshot(history);
+  history->mark = history->cursor;
+}
+
+void snapshot_history_compare(struct alsa_card *card) {
+  struct snapshot_history *history = card->snapshot_history;
+
+  if (!history)
+    return;
+
+  capture_snapshot(history);
+
+  if (history->mark < 0 || history->mark == history->cursor)
+    return;
+
+  int target = history->mark;
+
+  history->mark = history->cursor;
+  restore_state(history, target);
+}
+
+static void add_slot(
+  struct snapshot_history *history,
+  struct alsa_elem        *elem
+) {
+  struct snapshot_slot *slot = &history->slots[history->slot_count++];
+
+  slot->history = history;
+  slot->elem = elem;
+  slot->value = alsa_get_elem_value(elem);
+
+  alsa_elem_add_callback(elem, slot_elem_changed, slot, NULL);
+}
+
+void snapshot_history_init(struct alsa_card *card) {
+  if (!card->routing_snks)
+    return;
+
+  struct snapshot_history *history =
+    g_malloc0(sizeof(struct snapshot_history));
+
+  int max_slots = card->routing_snks->len + MAX_MIX_OUT * MAX_MUX_IN;
+
+  history->card = card;
+  history->slots = g_malloc0(max_slots * sizeof(struct snapshot_slot));
+  history->dirty_slots = g_malloc(max_slots * sizeof(int));
+  history->mark = -1;
+
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+
+    add_slot(history, r_snk->elem);
+  }
+
+  for (int mix = 0; mix < MAX_MIX_OUT; mix++)
+    for (int input = 0; input < MAX_MUX_IN; input++)
+      if (card->mixer_gains[mix][input])
+        add_slot(history, card->mixer_gains[mix][input]);
+
+  card->snapshot_history = history;
+}
+
+void snapshot_history_free(struct alsa_card *card) {
+  struct snapshot_history *history = card->snapshot_history;
+
+  if (!history)
+    return;
+
+  if (history->capture_timer)
+    g_source_remove(history->capture_timer);
+
+  for (int i = 0; i < history->count; i++)
+    free_snapshot(get_snapshot(history, i));
+
+  g_free(history->slots);
+  g_free(history->dirty_slots);
+  g_free(history);
+
+  card->snapshot_history = NULL;
+}
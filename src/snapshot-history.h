@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "alsa.h"
+
+// Undo/redo and A/B history of the routing and mixer state.
+//
+// Changes to the routing sinks and mixer gains are collected for a
+// short time and then stored as one snapshot in a fixed-size ring.
+// Each snapshot only records the sinks and mixer cells that changed
+// (old and new value), so taking one on every edit is cheap.
+// Restoring a snapshot writes only the elements that differ from the
+// current values.
+
+// Start tracking the routing sinks and mixer gains of a card
+// Must be called after alsa_init_mixer_gains_cache()
+void snapshot_history_init(struct alsa_card *card);
+
+void snapshot_history_free(struct alsa_card *card);
+
+// Step back/forward through the history
+void snapshot_history_undo(struct alsa_card *card);
+void snapshot_history_redo(struct alsa_card *card);
+
+// Mark the current state for A/B comparison
+void snapshot_history_mark(struct alsa_card *card);
+
+// Swap between the current and the marked state
+void snapshot_history_compare(struct alsa_card *card);
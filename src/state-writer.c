@@ -0,0 +1,349 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+
+#include "debug.h"
+#include "state-writer.h"
+
+enum state_writer_op {
+  STATE_WRITER_SAVE,
+  STATE_WRITER_APPEND,
+  STATE_WRITER_WRITE,
+  STATE_WRITER_REMOVE
+};
+
+struct state_writer_job {
+  enum state_writer_op  op;
+  char                 *path;
+
+  // for STATE_WRITER_SAVE; owned by the worker once queued
+  GKeyFile             *key_file;
+
+  // for STATE_WRITER_APPEND and STATE_WRITER_WRITE
+  char                 *data;
+  gsize                 len;
+
+  state_writer_done_cb  done;
+  gpointer              cb_data;
+
+  // when the job was queued and how long the worker took (µs)
+  gint64                queued_time;
+  gint64                write_time;
+  gsize                 written;
+};
+
+// queued jobs, and whether one is running
+static GQueue   jobs = G_QUEUE_INIT;
+static gboolean running;
+
+// write latency (queued to finished) over all jobs
+static int    stat_count;
+static gint64 stat_total_time;
+static gint64 stat_max_time;
+
+static const char *op_names[] = { "save", "append", "write", "remove" };
+
+static void free_job(struct state_writer_job *job) {
+  g_free(job->path);
+  if (job->key_file)
+    g_key_file_free(job->key_file);
+  g_free(job->data);
+  g_free(job);
+}
+
+static int write_all(int fd, const char *data, gsize len) {
+  while (len) {
+    ssize_t written = write(fd, data, len);
+
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return -1;
+    }
+
+    data += written;
+    len -= written;
+  }
+
+  return 0;
+}
+
+static void set_errno_error(GError **error, const char *what, const char *path) {
+  int err = errno;
+
+  g_set_error(
+    error, G_FILE_ERROR, g_file_error_from_errno(err),
+    "Failed to %s %s: %s", what, path, g_strerror(err)
+  );
+}
+
+// fsync the directory containing path so that a rename in it is
+// durable
+static void sync_parent_dir(const char *path) {
+  char *dir = g_path_get_dirname(path);
+  int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+  if (fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+
+  g_free(dir);
+}
+
+// Write data to a temporary file next to path, fsync it, and rename
+// it over path
+static gboolean write_atomic(
+  const char  *path,
+  const char  *data,
+  gsize        len,
+  GError     **error
+) {
+  char *tmp_path = g_strdup_printf("%s.XXXXXX", path);
+  int fd = g_mkstemp_full(tmp_path, O_WRONLY | O_CLOEXEC, 0644);
+
+  if (fd < 0) {
+    set_errno_error(error, "create", tmp_path);
+    g_free(tmp_path);
+    return FALSE;
+  }
+
+  if (write_all(fd, data, len) < 0) {
+    set_errno_error(error, "write", tmp_path);
+    goto fail;
+  }
+
+  if (fsync(fd) < 0) {
+    set_errno_error(error, "sync", tmp_path);
+    goto fail;
+  }
+
+  if (close(fd) < 0) {
+    fd = -1;
+    set_errno_error(error, "close", tmp_path);
+    goto fail;
+  }
+  fd = -1;
+
+  if (g_rename(tmp_path, path) < 0) {
+    set_errno_error(error, "rename", tmp_path);
+    goto fail;
+  }
+
+  sync_parent_dir(path);
+  g_free(tmp_path);
+
+  return TRUE;
+
+fail:
+  if (fd >= 0)
+    close(fd);
+  g_unlink(tmp_path);
+  g_free(tmp_path);
+
+  return FALSE;
+}
+
+static gboolean append_sync(
+  const char  *path,
+  const char  *data,
+  gsize        len,
+  GError     **error
+) {
+  int fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+  if (fd < 0) {
+    set_errno_error(error, "open", path);
+    return FALSE;
+  }
+
+  gboolean ok = FALSE;
+
+  if (write_all(fd, data, len) < 0)
+    set_errno_error(error, "write", path);
+  else if (fsync(fd) < 0)
+    set_errno_error(error, "sync", path);
+  else
+    ok = TRUE;
+
+  close(fd);
+
+  return ok;
+}
+
+// Runs on a worker thread
+static void job_thread(
+  GTask        *task,
+  gpointer      source_object,
+  gpointer      task_data,
+  GCancellable *cancellable
+) {
+  struct state_writer_job *job = task_data;
+  gint64 start = g_get_monotonic_time();
+  GError *error = NULL;
+  gboolean ok = TRUE;
+
+  if (job->op == STATE_WRITER_SAVE) {
+    gsize len;
+    char *data = g_key_file_to_data(job->key_file, &len, NULL);
+
+    ok = write_atomic(job->path, data, len, &error);
+    job->written = len;
+    g_free(data);
+
+  } else if (job->op == STATE_WRITER_APPEND) {
+    ok = append_sync(job->path, job->data, job->len, &error);
+    job->written = job->len;
+
+  } else if (job->op == STATE_WRITER_WRITE) {
+    ok = write_atomic(job->path, job->data, job->len, &error);
+    job->written = job->len;
+
+  } else if (g_unlink(job->path) < 0 && errno != ENOENT) {
+    set_errno_error(&error, "remove", job->path);
+    ok = FALSE;
+  }
+
+  job->write_time = g_get_monotonic_time() - start;
+
+  if (ok)
+    g_task_return_boolean(task, TRUE);
+  else
+    g_task_return_error(task, error);
+}
+
+static void start_next_job(void);
+
+static void job_done(
+  GObject      *source_object,
+  GAsyncResult *result,
+  gpointer      user_data
+) {
+  struct state_writer_job *job = g_task_get_task_data(G_TASK(result));
+  GError *error = NULL;
+
+  g_task_propagate_boolean(G_TASK(result), &error);
+
+  gint64 latency = g_get_monotonic_time() - job->queued_time;
+
+  stat_count++;
+  stat_total_time += latency;
+  stat_max_time = MAX(stat_max_time, latency);
+
+  if (debug_enabled("state-writer"))
+    printf(
+      "STATE-WRITER: %s %s: %zu bytes, write %.1f ms, latency %.1f ms "
+        "(avg %.1f ms, max %.1f ms over %d)\n",
+      op_names[job->op], job->path, job->written,
+      job->write_time / 1000.0, latency / 1000.0,
+      stat_total_time / 1000.0 / stat_count, stat_max_time / 1000.0,
+      stat_count
+    );
+
+  if (error)
+    g_warning("%s", error->message);
+
+  if (job->done)
+    job->done(error, job->cb_data);
+
+  if (error)
+    g_error_free(error);
+
+  running = FALSE;
+  start_next_job();
+}
+
+static void start_next_job(void) {
+  if (running)
+    return;
+
+  struct state_writer_job *job = g_queue_pop_head(&jobs);
+  if (!job)
+    return;
+
+  running = TRUE;
+
+  GTask *task = g_task_new(NULL, NULL, job_done, NULL);
+  g_task_set_task_data(task, job, (GDestroyNotify)free_job);
+  g_task_run_in_thread(task, job_thread);
+  g_object_unref(task);
+}
+
+static void queue_job(
+  enum state_writer_op  op,
+  const char           *path,
+  state_writer_done_cb  done,
+  gpointer              cb_data,
+  GKeyFile             *key_file,
+  char                 *data,
+  gsize                 len
+) {
+  struct state_writer_job *job = g_malloc0(sizeof(struct state_writer_job));
+
+  job->op = op;
+  job->path = g_strdup(path);
+  job->key_file = key_file;
+  job->data = data;
+  job->len = len;
+  job->done = done;
+  job->cb_data = cb_data;
+  job->queued_time = g_get_monotonic_time();
+
+  g_queue_push_tail(&jobs, job);
+  start_next_job();
+}
+
+void state_writer_save(
+  GKeyFile             *key_file,
+  const char           *path,
+  state_writer_done_cb  done,
+  gpointer              data
+) {
+  queue_job(STATE_WRITER_SAVE, path, done, data, key_file, NULL, 0);
+}
+
+void state_writer_append(
+  const char           *path,
+  const char           *data,
+  gsize                 len,
+  state_writer_done_cb  done,
+  gpointer              cb_data
+) {
+  char *copy = g_malloc(len);
+
+  memcpy(copy, data, len);
+  queue_job(STATE_WRITER_APPEND, path, done, cb_data, NULL, copy, len);
+}
+
+void state_writer_write(
+  const char           *path,
+  const char           *data,
+  gsize                 len,
+  state_writer_done_cb  done,
+  gpointer              cb_data
+) {
+  char *copy = g_malloc(len);
+
+  memcpy(copy, data, len);
+  queue_job(STATE_WRITER_WRITE, path, done, cb_data, NULL, copy, len);
+}
+
+void state_writer_remove(
+  const char           *path,
+  state_writer_done_cb  done,
+  gpointer              data
+) {
+  queue_job(STATE_WRITER_REMOVE, path, done, data, NULL, NULL, 0);
+}
+
+void state_writer_flush(void) {
+  while (running || !g_queue_is_empty(&jobs))
+    g_main_context_iteration(NULL, TRUE);
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <glib.h>
+
+// Background writer for the state, preset, and configuration files.
+//
+// Writes are queued on the main thread and run one at a time, in
+// order, on a worker thread so that slow filesystems don't block the
+// UI. A key file is serialised on the worker and replaces the
+// destination atomically (temporary file, fsync, rename), so a crash
+// leaves either the old or the new contents.
+
+// Called on the main thread when an operation has finished; error is
+// NULL on success. The next queued operation starts after this
+// returns.
+typedef void (*state_writer_done_cb)(const GError *error, gpointer data);
+
+// Write a key file to path, taking ownership of key_file
+void state_writer_save(
+  GKeyFile             *key_file,
+  const char           *path,
+  state_writer_done_cb  done,
+  gpointer              data
+);
+
+// Append len bytes of data to path and fsync it
+void state_writer_append(
+  const char           *path,
+  const char           *data,
+  gsize                 len,
+  state_writer_done_cb  done,
+  gpointer              cb_data
+);
+
+// Replace path with len bytes of data, atomically as for key files
+void state_writer_write(
+  const char           *path,
+  const char           *data,
+  gsize                 len,
+  state_writer_done_cb  done,
+  gpointer              cb_data
+);
+
+// Remove path if it exists
+void state_writer_remove(
+  const char           *path,
+  state_writer_done_cb  done,
+  gpointer              data
+);
+
+// Wait for all queued operations to finish
+void state_writer_flush(void);
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Test program for the batch biquad frequency response evaluator
+// Build from src/: make test
+// Run: ./tests/test-biquad-response
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "biquad.h"
+
+#define SAMPLE_RATE 48000.0
+
+// same grid as the PEQ response graph, plus DC and Nyquist
+#define N_FREQS 351
+
+// maximum error with fast_log set
+#define FAST_TOLERANCE_DB 0.001
+
+#define BENCH_ITERATIONS 2000
+#define BENCH_BANDS 8
+
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+static double freqs[N_FREQS];
+
+static void init_freqs(void) {
+  double freq = 20.0;
+  for (int i = 0; i < N_FREQS - 2; i++, freq *= 1.02)
+    freqs[i] = freq;
+  freqs[N_FREQS - 2] = 0;
+  freqs[N_FREQS - 1] = SAMPLE_RATE / 2;
+}
+
+static void test_response(
+  const struct biquad_freq_table *table,
+  const struct biquad_params     *params
+) {
+  struct biquad_coeffs coeffs;
+  biquad_calculate(params, SAMPLE_RATE, &coeffs);
+
+  double exact[N_FREQS], fast[N_FREQS];
+  biquad_response_db_batch(&coeffs, 1, table, FALSE, exact);
+  biquad_response_db_batch(&coeffs, 1, table, TRUE, fast);
+
+  double max_exact_err = 0, max_fast_err = 0;
+  for (int i = 0; i < N_FREQS; i++) {
+    double ref = biquad_response_db(&coeffs, freqs[i], SAMPLE_RATE);
+    max_exact_err = fmax(max_exact_err, fabs(exact[i] - ref));
+    max_fast_err = fmax(max_fast_err, fabs(fast[i] - ref));
+  }
+
+  test_count++;
+  if (max_exact_err < 1e-9 && max_fast_err < FAST_TOLERANCE_DB) {
+    pass_count++;
+  } else {
+    fail_count++;
+    printf("FAIL: %s freq=%.1f Q=%.2f gain=%.1f\n",
+           biquad_type_name(params->type),
+           params->freq, params->q, params->gain_db);
+    printf("  max error: exact %.3g dB, fast %.3g dB\n",
+           max_exact_err, max_fast_err);
+  }
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// time a full PEQ graph worth of bands with each method
+static void bench_response(const struct biquad_freq_table *table) {
+  struct biquad_coeffs coeffs[BENCH_BANDS];
+  double db[BENCH_BANDS * N_FREQS];
+  volatile double sink = 0;
+
+  for (int b = 0; b < BENCH_BANDS; b++) {
+    struct biquad_params params = {
+      .type = b % BIQUAD_TYPE_COUNT,
+      .freq = 50.0 * (b + 1) * (b + 1),
+      .q = 0.707,
+      .gain_db = 6.0
+    };
+    biquad_calculate(&params, SAMPLE_RATE, &coeffs[b]);
+  }
+
+  double start = now();
+  for (int n = 0; n < BENCH_ITERATIONS; n++)
+    for (int b = 0; b < BENCH_BANDS; b++)
+      for (int i = 0; i < N_FREQS; i++)
+        db[b * N_FREQS + i] =
+          biquad_response_db(&coeffs[b], freqs[i], SAMPLE_RATE);
+  double t_scalar = now() - start;
+  sink += db[0];
+
+  start = now();
+  for (int n = 0; n < BENCH_ITERATIONS; n++)
+    biquad_response_db_batch(coeffs, BENCH_BANDS, table, FALSE, db);
+  double t_batch = now() - start;
+  sink += db[0];
+
+  start = now();
+  for (int n = 0; n < BENCH_ITERATIONS; n++)
+    biquad_response_db_batch(coeffs, BENCH_BANDS, table, TRUE, db);
+  double t_fast = now() - start;
+  sink += db[0];
+
+  printf("Benchmark (%d bands x %d frequencies):\n", BENCH_BANDS, N_FREQS);
+  printf("  scalar      %8.2f us\n", t_scalar * 1e6 / BENCH_ITERATIONS);
+  printf("  batch       %8.2f us  (%.1fx)\n",
+         t_batch * 1e6 / BENCH_ITERATIONS, t_scalar / t_batch);
+  printf("  batch fast  %8.2f us  (%.1fx)\n",
+         t_fast * 1e6 / BENCH_ITERATIONS, t_scalar / t_fast);
+}
+
+int main(void) {
+  double test_freqs[] = { 20, 100, 1000, 5000, 15000, 20000 };
+  double qs[] = { 0.1, 0.707, 2.0, 10.0 };
+  double gains[] = { -GAIN_DB_LIMIT, -6, 0, 6, GAIN_DB_LIMIT };
+
+  int n_freqs = sizeof(test_freqs) / sizeof(test_freqs[0]);
+  int n_qs = sizeof(qs) / sizeof(qs[0]);
+  int n_gains = sizeof(gains) / sizeof(gains[0]);
+
+  init_freqs();
+
+  struct biquad_freq_table table;
+  biquad_freq_table_init(&table, freqs, N_FREQS, SAMPLE_RATE);
+
+  printf("Testing batch biquad response...\n\n");
+
+  for (int type = 0; type < BIQUAD_TYPE_COUNT; type++)
+    for (int fi = 0; fi < n_freqs; fi++)
+      for (int qi = 0; qi < n_qs; qi++)
+        for (int gi = 0; gi < n_gains; gi++) {
+          struct biquad_params params = {
+            .type = type,
+            .freq = test_freqs[fi],
+            .q = qs[qi],
+            .gain_db = gains[gi]
+          };
+          test_response(&table, &params);
+        }
+
+  bench_response(&table);
+
+  biquad_freq_table_free(&table);
+
+  printf("\n========================================\n");
+  printf("Results: %d tests, %d passed, %d failed\n",
+         test_count, pass_count, fail_count);
+
+  return fail_count > 0 ? 1 : 0;
+}
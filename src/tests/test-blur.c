@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Test program for the mixer label glow box blur
+// Build from src/: make test
+// Run: ./tests/test-blur
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "blur.h"
+
+// typical glow surface sizes: label text plus 2 × 29 pixels padding
+static const int sizes[][2] = {
+  { 1, 1 }, { 3, 2 }, { 7, 40 }, { 40, 7 },
+  { 90, 75 }, { 128, 75 }, { 200, 75 }, { 260, 90 }
+};
+
+static const int radii[] = { 0, 1, 3, 9, 31, 40 };
+
+#define N_SIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+#define N_RADII (int)(sizeof(radii) / sizeof(radii[0]))
+
+#define BENCH_ITERATIONS 2000
+
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+// fill an alpha plane with a mix of solid "text" blocks and noise
+static void fill_plane(unsigned char *plane, int width, int height) {
+  for (int y = 0; y < height; y++)
+    for (int x = 0; x < width; x++)
+      plane[y * width + x] =
+        ((x / 5 + y / 3) % 3 == 0) ? 255 : rand() % 256;
+}
+
+// reference implementation: a single-pass box blur of the alpha
+// channel of an ARGB32 image surface, in-place. uses a temporary
+// buffer to avoid read-after-write hazards.
+static void box_blur_alpha(
+  unsigned char *data,
+  int            width,
+  int            height,
+  int            stride,
+  int            radius
+) {
+  // horizontal pass — blur each row into a temp buffer,
+  // then copy back
+  unsigned char *tmp = g_malloc(
+    MAX(width, height) * sizeof(unsigned char)
+  );
+
+  for (int y = 0; y < height; y++) {
+    unsigned char *row = data + y * stride;
+
+    // build initial window for x=0: [0, min(radius, width-1)]
+    int right = MIN(radius, width - 1);
+    int sum = 0;
+    for (int x = 0; x <= right; x++)
+      sum += row[x * 4 + 3];
+
+    for (int x = 0; x < width; x++) {
+      int count = MIN(x, radius) + MIN(width - 1 - x, radius) + 1;
+      tmp[x] = sum / count;
+
+      // slide window: remove departing left, add arriving right
+      int rem = x - radius;
+      int add = x + radius + 1;
+      if (rem >= 0)
+        sum -= row[rem * 4 + 3];
+      if (add < width)
+        sum += row[add * 4 + 3];
+    }
+
+    for (int x = 0; x < width; x++)
+      row[x * 4 + 3] = tmp[x];
+  }
+
+  // vertical pass — blur each column into a temp buffer,
+  // then copy back
+  for (int x = 0; x < width; x++) {
+    int off = x * 4 + 3;
+
+    // build initial window for y=0: [0, min(radius, height-1)]
+    int bottom = MIN(radius, height - 1);
+    int sum = 0;
+    for (int y = 0; y <= bottom; y++)
+      sum += data[y * stride + off];
+
+    for (int y = 0; y < height; y++) {
+      int count =
+        MIN(y, radius) + MIN(height - 1 - y, radius) + 1;
+      tmp[y] = sum / count;
+
+      // slide window: remove departing top, add arriving bottom
+      int rem = y - radius;
+      int add = y + radius + 1;
+      if (rem >= 0)
+        sum -= data[rem * stride + off];
+      if (add < height)
+        sum += data[add * stride + off];
+    }
+
+    for (int y = 0; y < height; y++)
+      data[y * stride + off] = tmp[y];
+  }
+
+  g_free(tmp);
+}
+
+// run the reference blur on an ARGB32 copy of the plane
+static void reference_blur(
+  const unsigned char *plane,
+  unsigned char       *out,
+  int                  width,
+  int                  height,
+  int                  radius
+) {
+  int stride = width * 4;
+  unsigned char *data = calloc(stride * height, 1);
+
+  for (int y = 0; y < height; y++)
+    for (int x = 0; x < width; x++)
+      data[y * stride + x * 4 + 3] = plane[y * width + x];
+
+  for (int pass = 0; pass < 3; pass++)
+    box_blur_alpha(data, width, height, stride, radius);
+
+  for (int y = 0; y < height; y++)
+    for (int x = 0; x < width; x++)
+      out[y * width + x] = data[y * stride + x * 4 + 3];
+
+  free(data);
+}
+
+static void test_blur(int width, int height, int radius) {
+  unsigned char *plane = malloc(width * height);
+  unsigned char *expected = malloc(width * height);
+
+  fill_plane(plane, width, height);
+  reference_blur(plane, expected, width, height, radius);
+  box_blur_plane(plane, width, height, radius, 3);
+
+  test_count++;
+
+  int diffs = 0;
+  for (int i = 0; i < width * height; i++)
+    if (plane[i] != expected[i])
+      diffs++;
+
+  if (!diffs) {
+    pass_count++;
+  } else {
+    fail_count++;
+    printf("FAIL: %dx%d radius=%d: %d of %d pixels differ\n",
+           width, height, radius, diffs, width * height);
+  }
+
+  free(expected);
+  free(plane);
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// time both implementations for the two glow radii of one label
+static void bench_blur(int width, int height) {
+  int stride = width * 4;
+  unsigned char *plane = malloc(width * height);
+  unsigned char *data = calloc(stride * height, 1);
+
+  fill_plane(plane, width, height);
+
+  double start = now();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    for (int r = 3; r <= 9; r += 6)
+      for (int pass = 0; pass < 3; pass++)
+        box_blur_alpha(data, width, height, stride, r);
+  double t_ref = now() - start;
+
+  start = now();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    for (int r = 3; r <= 9; r += 6)
+      box_blur_plane(plane, width, height, r, 3);
+  double t_new = now() - start;
+
+  printf("  %3dx%-3d  reference %7.2f us  plane %7.2f us  (%.1fx)\n",
+         width, height,
+         t_ref * 1e6 / BENCH_ITERATIONS,
+         t_new * 1e6 / BENCH_ITERATIONS,
+         t_ref / t_new);
+
+  free(data);
+  free(plane);
+}
+
+int main(void) {
+  srand(1);
+
+  printf("Testing box blur...\n\n");
+
+  for (int si = 0; si < N_SIZES; si++)
+    for (int ri = 0; ri < N_RADII; ri++)
+      test_blur(sizes[si][0], sizes[si][1], radii[ri]);
+
+  printf("Benchmark (per label, radii 3 and 9, 3 passes each):\n");
+  for (int si = 4; si < N_SIZES; si++)
+    bench_blur(sizes[si][0], sizes[si][1]);
+
+  printf("\n========================================\n");
+  printf("Results: %d tests, %d passed, %d failed\n",
+         test_count, pass_count, fail_count);
+
+  return fail_count > 0 ? 1 : 0;
+}
@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2026 Geoffrey D. Bennett <g@b4.vu>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Test program for the routing window hit-test grid
+// Build from src/: make test
+// Run: ./tests/test-hit-grid
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hit-grid.h"
+
+#define N_RECTS 200
+#define N_POINTS 20000
+
+#define BENCH_ITERATIONS 200000
+
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+static struct hit_rect rects[N_RECTS];
+
+// reference: first rectangle containing the point
+static void *linear_lookup(int count, float x, float y) {
+  for (int i = 0; i < count; i++) {
+    struct hit_rect *rect = &rects[i];
+
+    if (x >= rect->x && x <= rect->x + rect->w &&
+        y >= rect->y && y <= rect->y + rect->h)
+      return rect->data;
+  }
+
+  return NULL;
+}
+
+static float frand(float max) {
+  return (float)rand() / RAND_MAX * max;
+}
+
+// routing-window-like layout: rows of equal sized sockets+labels,
+// plus some overlapping and oversized rectangles
+static void make_rects(int count) {
+  for (int i = 0; i < count; i++) {
+    struct hit_rect *rect = &rects[i];
+
+    if (i % 10 == 9) {
+      rect->x = frand(1200);
+      rect->y = frand(800);
+      rect->w = frand(300);
+      rect->h = frand(200);
+    } else {
+      rect->x = 20 + (i % 24) * 48;
+      rect->y = 40 + (i / 24) * 90;
+      rect->w = 40;
+      rect->h = 80;
+    }
+    rect->data = &rects[i];
+  }
+}
+
+static void test_lookup(const char *name, int count) {
+  struct hit_grid grid;
+
+  hit_grid_init(&grid);
+  make_rects(count);
+  for (int i = 0; i < count; i++)
+    hit_grid_add(
+      &grid, rects[i].x, rects[i].y, rects[i].w, rects[i].h, rects[i].data
+    );
+  hit_grid_build(&grid);
+
+  test_count++;
+
+  int diffs = 0;
+  for (int i = 0; i < N_POINTS; i++) {
+    float x = frand(1600) - 100;
+    float y = frand(1000) - 100;
+
+    // also hit rectangle edges exactly
+    if (count && i % 4 == 0) {
+      struct hit_rect *rect = &rects[rand() % count];
+      x = rect->x + (i % 8 ? rect->w : 0);
+      y = rect->y + (i % 16 < 8 ? rect->h : 0);
+    }
+
+    if (hit_grid_lookup(&grid, x, y) != linear_lookup(count, x, y))
+      diffs++;
+  }
+
+  if (!diffs) {
+    pass_count++;
+  } else {
+    fail_count++;
+    printf("FAIL: %s: %d of %d points differ\n", name, diffs, N_POINTS);
+  }
+
+  hit_grid_free(&grid);
+}
+
+// rebuilding after clear must give the same results as a new grid
+static void test_rebuild(void) {
+  struct hit_grid grid;
+
+  hit_grid_init(&grid);
+  make_rects(N_RECTS);
+  for (int i = 0; i < N_RECTS; i++)
+    hit_grid_add(&grid, i * 1000, i * 1000, 10, 10, NULL);
+  hit_grid_build(&grid);
+
+  hit_grid_clear(&grid);
+  for (int i = 0; i < N_RECTS; i++)
+    hit_grid_add(
+      &grid, rects[i].x, rects[i].y, rects[i].w, rects[i].h, rects[i].data
+    );
+  hit_grid_build(&grid);
+
+  test_count++;
+
+  int diffs = 0;
+  for (int i = 0; i < N_POINTS; i++) {
+    float x = frand(1400);
+    float y = frand(900);
+
+    if (hit_grid_lookup(&grid, x, y) != linear_lookup(N_RECTS, x, y))
+      diffs++;
+  }
+
+  if (!diffs) {
+    pass_count++;
+  } else {
+    fail_count++;
+    printf("FAIL: rebuild: %d of %d points differ\n", diffs, N_POINTS);
+  }
+
+  hit_grid_free(&grid);
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_lookup(void) {
+  struct hit_grid grid;
+  static float xs[N_POINTS], ys[N_POINTS];
+  int hits_ref = 0, hits_new = 0;
+
+  hit_grid_init(&grid);
+  make_rects(N_RECTS);
+  for (int i = 0; i < N_RECTS; i++)
+    hit_grid_add(
+      &grid, rects[i].x, rects[i].y, rects[i].w, rects[i].h, rects[i].data
+    );
+  hit_grid_build(&grid);
+
+  for (int i = 0; i < N_POINTS; i++) {
+    xs[i] = frand(1200);
+    ys[i] = frand(800);
+  }
+
+  double start = now();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    hits_ref += !!linear_lookup(N_RECTS, xs[i % N_POINTS], ys[i % N_POINTS]);
+  double t_ref = now() - start;
+
+  start = now();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    hits_new += !!hit_grid_lookup(&grid, xs[i % N_POINTS], ys[i % N_POINTS]);
+  double t_new = now() - start;
+
+  if (hits_ref != hits_new)
+    printf("FAIL: benchmark hit counts differ\n");
+
+  printf("  %d rects  linear %6.1f ns  grid %6.1f ns  (%.1fx)\n",
+         N_RECTS,
+         t_ref * 1e9 / BENCH_ITERATIONS,
+         t_new * 1e9 / BENCH_ITERATIONS,
+         t_ref / t_new);
+
+  hit_grid_free(&grid);
+}
+
+int main(void) {
+  srand(1);
+
+  printf("Testing hit grid...\n\n");
+
+  test_lookup("empty", 0);
+  test_lookup("single", 1);
+  test_lookup("small", 10);
+  test_lookup("full", N_RECTS);
+  test_rebuild();
+
+  printf("Benchmark (lookup, excluding bounds queries):\n");
+  bench_lookup();
+
+  printf("\n========================================\n");
+  printf("Results: %d tests, %d passed, %d failed\n",
+         test_count, pass_count, fail_count);
+
+  return fail_count > 0 ? 1 : 0;
+}
@@ -12,6 +12,7 @@
 #include "port-enable.h"
 #include "widget-text-entry.h"
 #include "window-configuration.h"
+#include "window-helper.h"
 #include "config-autogain.h"
 #include "config-device-name.h"
 #include "config-device-settings.h"
@@ -124,6 +125,50 @@ GtkWidget *wrap_tab_content_scrolled(GtkWidget *content) {
   return scrolled;
 }
 
+// Data for a notebook page that hasn't been built yet
+struct lazy_page_data {
+  notebook_page_build_func  build;
+  struct alsa_card         *card;
+};
+
+// Build the page contents when it's first shown
+static void lazy_page_mapped(GtkWidget *page, gpointer user_data) {
+  struct lazy_page_data *data = user_data;
+  notebook_page_build_func build = data->build;
+  struct alsa_card *card = data->card;
+
+  // only build once (this frees data)
+  g_signal_handlers_disconnect_by_func(page, lazy_page_mapped, data);
+
+  build(page, card);
+}
+
+GtkWidget *append_lazy_notebook_page(
+  GtkNotebook              *notebook,
+  const char               *page_id,
+  GtkWidget                *tab_label,
+  notebook_page_build_func  build,
+  struct alsa_card         *card
+) {
+  GtkWidget *page = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
+  gtk_widget_set_vexpand(page, TRUE);
+
+  struct lazy_page_data *data = g_malloc(sizeof(struct lazy_page_data));
+  data->build = build;
+  data->card = card;
+
+  // freed when the handler is disconnected or the page destroyed
+  g_signal_connect_data(
+    page, "map", G_CALLBACK(lazy_page_mapped), data,
+    (GClosureNotify)g_free, 0
+  );
+
+  g_object_set_data(G_OBJECT(page), PAGE_ID_KEY, (gpointer)page_id);
+  gtk_notebook_append_page(notebook, page, tab_label);
+
+  return page;
+}
+
 GtkWidget *create_configuration_controls(struct alsa_card *card) {
   struct configuration_window *data =
     g_malloc0(sizeof(struct configuration_window));
@@ -179,3 +224,27 @@ GtkWidget *create_configuration_controls(struct alsa_card *card) {
 
   return data->top;
 }
+
+static gboolean window_configuration_close_request(GtkWindow *w, gpointer data) {
+  struct alsa_card *card = data;
+
+  gtk_widget_activate_action(
+    card->window_main,
+    "win.configuration",
+    NULL
+  );
+
+  return true;
+}
+
+GtkWidget *create_configuration_window(struct alsa_card *card) {
+  GtkWidget *w = create_subwindow(
+    card, "Configuration", G_CALLBACK(window_configuration_close_request)
+  );
+  gtk_window_set_resizable(GTK_WINDOW(w), TRUE);
+
+  GtkWidget *configuration = create_configuration_controls(card);
+  gtk_window_set_child(GTK_WINDOW(w), configuration);
+
+  return w;
+}
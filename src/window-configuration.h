@@ -11,6 +11,22 @@
 // Wrap tab content in a scrolled window (shared by config-*.c)
 GtkWidget *wrap_tab_content_scrolled(GtkWidget *content);
 
+// Build the contents of a lazily-built notebook page into page
+typedef void (*notebook_page_build_func)(
+  GtkWidget        *page,
+  struct alsa_card *card
+);
+
+// Append a notebook page whose contents are built the first time
+// the page is shown (shared by config-*.c); returns the page
+GtkWidget *append_lazy_notebook_page(
+  GtkNotebook              *notebook,
+  const char               *page_id,
+  GtkWidget                *tab_label,
+  notebook_page_build_func  build,
+  struct alsa_card         *card
+);
+
 // Setup notebook tab persistence (shared by config-*.c)
 void setup_notebook_tab_persistence(
   GtkNotebook      *notebook,
@@ -19,3 +35,6 @@ void setup_notebook_tab_persistence(
 );
 
 GtkWidget *create_configuration_controls(struct alsa_card *card);
+
+// Create the Configuration window (not shown)
+GtkWidget *create_configuration_window(struct alsa_card *card);
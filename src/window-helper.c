@@ -50,6 +50,16 @@ static gboolean on_key_press(
       case GDK_KEY_slash: action = "win.about";     break;
       case GDK_KEY_q: action = "app.quit";          break;
       case GDK_KEY_h: action = "app.hardware";      break;
+
+      // with Shift, the keyval is usually the upper case one
+      case GDK_KEY_z:
+      case GDK_KEY_Z:
+        action = (state & GDK_SHIFT_MASK) ? "win.redo" : "win.undo";
+        break;
+      case GDK_KEY_b:
+      case GDK_KEY_B:
+        action = (state & GDK_SHIFT_MASK) ? "win.ab-mark" : "win.ab-compare";
+        break;
     }
 
     if (action) {
@@ -2,8 +2,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <gtk/gtk.h>
+#include <stdio.h>
 #include <string.h>
 
+#include "debug.h"
 #include "iface-mixer.h"
 #include "iface-no-mixer.h"
 #include "iface-none.h"
@@ -117,10 +119,14 @@ static void cleanup_gain_widget_lists(struct alsa_card *card) {
   g_list_free(card->output_gain_widgets);
   card->output_gain_widgets = NULL;
 
+  if (card->mixer_cells_idle) {
+    g_source_remove(card->mixer_cells_idle);
+    card->mixer_cells_idle = 0;
+  }
+
   for (GList *l = card->mixer_gain_widgets; l != NULL; l = l->next) {
     struct mixer_gain_widget *mg = l->data;
-    if (mg->widget)
-      g_object_unref(mg->widget);
+    g_object_unref(mg->cell);
     g_free(mg);
   }
   g_list_free(card->mixer_gain_widgets);
@@ -193,6 +199,8 @@ void create_card_window(struct alsa_card *card) {
     no_cards_window = NULL;
   }
 
+  gint64 start = g_get_monotonic_time();
+
   // Replacing an existing window
   if (card->window_main)
     gtk_window_destroy(GTK_WINDOW(card->window_main));
@@ -345,6 +353,12 @@ void create_card_window(struct alsa_card *card) {
     alsa_elem_add_callback(name_elem, update_window_titles, card, NULL);
 
   gtk_widget_set_visible(card->window_main, TRUE);
+
+  if (debug_enabled("window-timing"))
+    printf(
+      "WINDOW-TIMING: created %s main window in %.1f ms\n",
+      card->name, (g_get_monotonic_time() - start) / 1000.0
+    );
 }
 
 void create_no_card_window(void) {
@@ -9,6 +9,7 @@
 #include "gtkhelper.h"
 #include "glow.h"
 #include "iface-mixer.h"
+#include "routing-lines.h"
 #include "stringhelper.h"
 #include "widget-gain.h"
 #include "window-dsp.h"
@@ -78,7 +79,7 @@ static int update_levels_controls(void *user_data) {
     }
 
     if (routing_visible)
-      gtk_widget_queue_draw(card->routing_lines);
+      routing_lines_levels_updated(card);
 
     if (mixer_visible && card->mixer_glow)
       gtk_widget_queue_draw(card->mixer_glow);
@@ -89,6 +90,10 @@ static int update_levels_controls(void *user_data) {
     for (GList *l = card->mixer_gain_widgets; l; l = l->next) {
       struct mixer_gain_widget *mg = l->data;
 
+      // skip cells that are scrolled out of view
+      if (!mg->widget)
+        continue;
+
       // get the routing source connected to this mixer input
       if (!mg->r_snk || !mg->r_snk->elem)
         continue;
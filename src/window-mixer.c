@@ -6,6 +6,7 @@
 #include <math.h>
 
 #include "alsa.h"
+#include "blur.h"
 #include "custom-names.h"
 #include "glow.h"
 #include "gtkhelper.h"
@@ -22,15 +23,10 @@ struct rotated_label_info {
   int              text_w;
   int              text_h;
   gboolean         hover;
-  cairo_surface_t *glow_cache;
-  int              glow_cache_w;
-  int              glow_cache_h;
 };
 
 static void rotated_label_info_free(gpointer data) {
   struct rotated_label_info *info = data;
-  if (info->glow_cache)
-    cairo_surface_destroy(info->glow_cache);
   g_free(info->text);
   g_free(info);
 }
@@ -432,80 +428,6 @@ static void draw_mixer_glow(
 // mixer_gain_widgets is stored in card->mixer_gain_widgets
 // struct mixer_gain_widget is declared in window-mixer.h
 
-// apply a single-pass box blur to the alpha channel of an ARGB32
-// image surface. operates on raw pixel data in-place. uses a
-// temporary buffer to avoid read-after-write hazards.
-static void box_blur_alpha(
-  unsigned char *data,
-  int            width,
-  int            height,
-  int            stride,
-  int            radius
-) {
-  // horizontal pass — blur each row into a temp buffer,
-  // then copy back
-  unsigned char *tmp = g_malloc(
-    MAX(width, height) * sizeof(unsigned char)
-  );
-
-  for (int y = 0; y < height; y++) {
-    unsigned char *row = data + y * stride;
-
-    // build initial window for x=0: [0, min(radius, width-1)]
-    int right = MIN(radius, width - 1);
-    int sum = 0;
-    for (int x = 0; x <= right; x++)
-      sum += row[x * 4 + 3];
-
-    for (int x = 0; x < width; x++) {
-      int count = MIN(x, radius) + MIN(width - 1 - x, radius) + 1;
-      tmp[x] = sum / count;
-
-      // slide window: remove departing left, add arriving right
-      int rem = x - radius;
-      int add = x + radius + 1;
-      if (rem >= 0)
-        sum -= row[rem * 4 + 3];
-      if (add < width)
-        sum += row[add * 4 + 3];
-    }
-
-    for (int x = 0; x < width; x++)
-      row[x * 4 + 3] = tmp[x];
-  }
-
-  // vertical pass — blur each column into a temp buffer,
-  // then copy back
-  for (int x = 0; x < width; x++) {
-    int off = x * 4 + 3;
-
-    // build initial window for y=0: [0, min(radius, height-1)]
-    int bottom = MIN(radius, height - 1);
-    int sum = 0;
-    for (int y = 0; y <= bottom; y++)
-      sum += data[y * stride + off];
-
-    for (int y = 0; y < height; y++) {
-      int count =
-        MIN(y, radius) + MIN(height - 1 - y, radius) + 1;
-      tmp[y] = sum / count;
-
-      // slide window: remove departing top, add arriving bottom
-      int rem = y - radius;
-      int add = y + radius + 1;
-      if (rem >= 0)
-        sum -= data[rem * stride + off];
-      if (add < height)
-        sum += data[add * stride + off];
-    }
-
-    for (int y = 0; y < height; y++)
-      data[y * stride + off] = tmp[y];
-  }
-
-  g_free(tmp);
-}
-
 // build the blurred green text-shadow glow surface for a label.
 // matches CSS: text-shadow: 0 0 5px #00c000, 0 0 15px #00c000.
 // CSS blur-radius ≈ 2σ; 3 box-blur passes at radius r give
@@ -514,10 +436,11 @@ static cairo_surface_t *build_glow_surface(
   PangoLayout *layout,
   int          text_w,
   int          text_h,
-  int          pad
+  int          pad,
+  int          scale
 ) {
-  int surf_w = text_w + pad * 2;
-  int surf_h = text_h + pad * 2;
+  int surf_w = (text_w + pad * 2) * scale;
+  int surf_h = (text_h + pad * 2) * scale;
 
   static const int radii[] = { 3, 9 };
 
@@ -528,6 +451,7 @@ static cairo_surface_t *build_glow_surface(
     cairo_surface_t *mask_surf = cairo_image_surface_create(
       CAIRO_FORMAT_ARGB32, surf_w, surf_h
     );
+    cairo_surface_set_device_scale(mask_surf, scale, scale);
     cairo_t *gc = cairo_create(mask_surf);
     cairo_set_source_rgba(gc, 1, 1, 1, 1);
     cairo_move_to(gc, pad, pad);
@@ -550,28 +474,24 @@ static cairo_surface_t *build_glow_surface(
   cairo_surface_t *result = cairo_image_surface_create(
     CAIRO_FORMAT_ARGB32, surf_w, surf_h
   );
+  cairo_surface_set_device_scale(result, scale, scale);
   cairo_t *gc = cairo_create(result);
 
+  unsigned char *blurred = g_malloc(surf_w * surf_h);
+
   for (int r = 0; r < 2; r++) {
     cairo_surface_t *surf = cairo_image_surface_create(
       CAIRO_FORMAT_ARGB32, surf_w, surf_h
     );
+    cairo_surface_set_device_scale(surf, scale, scale);
     cairo_surface_flush(surf);
     unsigned char *data =
       cairo_image_surface_get_data(surf);
     int stride = cairo_image_surface_get_stride(surf);
 
-    // seed alpha from text mask
-    for (int y = 0; y < surf_h; y++)
-      for (int x = 0; x < surf_w; x++)
-        data[y * stride + x * 4 + 3] =
-          text_mask[y * surf_w + x];
-
     // 3 box-blur passes ≈ Gaussian
-    for (int pass = 0; pass < 3; pass++)
-      box_blur_alpha(
-        data, surf_w, surf_h, stride, radii[r]
-      );
+    memcpy(blurred, text_mask, surf_w * surf_h);
+    box_blur_plane(blurred, surf_w, surf_h, radii[r] * scale, 3);
 
     // recolour to premultiplied #00c000. restore full
     // opacity where the original text was so the glow is
@@ -581,7 +501,7 @@ static cairo_surface_t *build_glow_surface(
     for (int y = 0; y < surf_h; y++) {
       unsigned char *row = data + y * stride;
       for (int x = 0; x < surf_w; x++) {
-        int a = row[x * 4 + 3];
+        int a = blurred[y * surf_w + x];
         int orig = text_mask[y * surf_w + x];
         if (orig > a)
           a = orig;
@@ -599,19 +519,115 @@ static cairo_surface_t *build_glow_surface(
   }
 
   cairo_destroy(gc);
+  g_free(blurred);
   g_free(text_mask);
 
   return result;
 }
 
+// maximum memory used by cached glow surfaces, shared by all cards
+#define GLOW_CACHE_MAX_BYTES (4 * 1024 * 1024)
+
+// cached glow surface, keyed by font, text, and scale
+struct glow_cache_entry {
+  char            *key;
+  cairo_surface_t *surface;
+  size_t           size;
+  GList           *lru_link;
+};
+
+// glow surfaces are cached by content rather than per label widget,
+// so they survive mixer grid rebuilds and are shared between
+// windows and cards; least-recently used entries are evicted
+static GHashTable *glow_cache;
+static GQueue      glow_cache_lru = G_QUEUE_INIT;
+static size_t      glow_cache_bytes;
+
+static void glow_cache_entry_free(gpointer data) {
+  struct glow_cache_entry *entry = data;
+
+  cairo_surface_destroy(entry->surface);
+  g_free(entry->key);
+  g_free(entry);
+}
+
+static void glow_cache_evict(size_t needed) {
+  while (glow_cache_bytes + needed > GLOW_CACHE_MAX_BYTES &&
+         glow_cache_lru.tail) {
+    struct glow_cache_entry *entry = glow_cache_lru.tail->data;
+
+    g_queue_delete_link(&glow_cache_lru, entry->lru_link);
+    glow_cache_bytes -= entry->size;
+    g_hash_table_remove(glow_cache, entry->key);
+  }
+}
+
+// look up or build the glow surface for a layout
+static cairo_surface_t *get_glow_surface(
+  PangoLayout *layout,
+  int          text_w,
+  int          text_h,
+  int          pad,
+  int          scale
+) {
+  if (!glow_cache)
+    glow_cache = g_hash_table_new_full(
+      g_str_hash, g_str_equal, NULL, glow_cache_entry_free
+    );
+
+  const PangoFontDescription *font =
+    pango_layout_get_font_description(layout);
+  if (!font)
+    font = pango_context_get_font_description(
+      pango_layout_get_context(layout)
+    );
+
+  char *font_str = pango_font_description_to_string(font);
+  char *key = g_strdup_printf(
+    "%s\n%d\n%s", font_str, scale, pango_layout_get_text(layout)
+  );
+  g_free(font_str);
+
+  struct glow_cache_entry *entry = g_hash_table_lookup(glow_cache, key);
+
+  if (entry) {
+    g_free(key);
+
+    // move to the front of the LRU list
+    g_queue_unlink(&glow_cache_lru, entry->lru_link);
+    g_queue_push_head_link(&glow_cache_lru, entry->lru_link);
+
+    return entry->surface;
+  }
+
+  cairo_surface_t *surface =
+    build_glow_surface(layout, text_w, text_h, pad, scale);
+  size_t size = (size_t)cairo_image_surface_get_stride(surface) *
+                cairo_image_surface_get_height(surface);
+
+  glow_cache_evict(size);
+
+  entry = g_malloc0(sizeof(struct glow_cache_entry));
+  entry->key = key;
+  entry->surface = surface;
+  entry->size = size;
+
+  g_queue_push_head(&glow_cache_lru, entry);
+  entry->lru_link = glow_cache_lru.head;
+  glow_cache_bytes += size;
+  g_hash_table_insert(glow_cache, key, entry);
+
+  return surface;
+}
+
 // draw cached blurred green text-shadow glow behind a label.
 // caller must set cairo position to text origin.
 static void draw_text_shadow_glow(
-  cairo_t                  *cr,
-  struct rotated_label_info *info,
-  PangoLayout              *layout,
-  int                       text_w,
-  int                       text_h
+  cairo_t     *cr,
+  PangoLayout *layout,
+  int          text_w,
+  int          text_h,
+  int          scale
 ) {
   if (text_w <= 0 || text_h <= 0)
     return;
@@ -619,21 +635,10 @@ static void draw_text_shadow_glow(
   static const int max_radius = 9;
   int pad = max_radius * 3 + 2;
 
-  // rebuild cache if dimensions changed
-  if (!info->glow_cache ||
-      info->glow_cache_w != text_w ||
-      info->glow_cache_h != text_h) {
-    if (info->glow_cache)
-      cairo_surface_destroy(info->glow_cache);
-    info->glow_cache =
-      build_glow_surface(layout, text_w, text_h, pad);
-    info->glow_cache_w = text_w;
-    info->glow_cache_h = text_h;
-  }
+  cairo_surface_t *glow =
+    get_glow_surface(layout, text_w, text_h, pad, scale);
 
-  cairo_set_source_surface(
-    cr, info->glow_cache, -pad, -pad
-  );
+  cairo_set_source_surface(cr, glow, -pad, -pad);
   cairo_paint(cr);
 }
 
@@ -694,7 +699,10 @@ static void draw_snk_label(
     cairo_translate(cr, -text_w, 0);
 
   if (info->hover) {
-    draw_text_shadow_glow(cr, info, layout, text_w, text_h);
+    draw_text_shadow_glow(
+      cr, layout, text_w, text_h,
+      gtk_widget_get_scale_factor(overlay_widget)
+    );
     cairo_set_source_rgb(cr, 1, 1, 1);
   } else {
     GdkRGBA color;
@@ -758,12 +766,6 @@ static void set_rotated_label_text(
   g_free(info->text);
   info->text = g_strdup(text);
 
-  // invalidate glow cache (dimensions may have changed)
-  if (info->glow_cache) {
-    cairo_surface_destroy(info->glow_cache);
-    info->glow_cache = NULL;
-  }
-
   // trigger redraw of label overlay
   struct alsa_card *card = g_object_get_data(G_OBJECT(widget), "card");
   if (card && card->mixer_label_overlay)
@@ -916,7 +918,226 @@ static struct routing_src *get_mixer_r_src(
   return NULL;
 }
 
-static void populate_mixer_gain_widgets(struct alsa_card *card) {
+// Mixer gain widgets available for reuse, by mixer position
+struct mixer_gain_reuse {
+  struct mixer_gain_widget *cells[MAX_MIX_OUT][MAX_MUX_IN];
+};
+
+// Take the mixer gain widget at a mixer position if it controls the
+// same elements, so it can be reused
+static struct mixer_gain_widget *take_reusable_gain_widget(
+  struct mixer_gain_reuse *reuse,
+  int                      mix_num,
+  int                      input_num,
+  struct alsa_elem       **elems,
+  int                      elem_count
+) {
+  if (!reuse)
+    return NULL;
+
+  struct mixer_gain_widget *mg = reuse->cells[mix_num][input_num];
+
+  if (!mg ||
+      mg->elem_count != elem_count ||
+      memcmp(mg->elems, elems, elem_count * sizeof(*elems)) != 0)
+    return NULL;
+
+  reuse->cells[mix_num][input_num] = NULL;
+  return mg;
+}
+
+// Record the size of a realised gain widget as the size of every
+// mixer cell, so that empty cells take up the same space and the
+// grid layout doesn't change as gain widgets come and go
+static void update_mixer_cell_size(
+  struct alsa_card *card,
+  GtkWidget        *w
+) {
+  int cell_w, cell_h;
+
+  gtk_widget_measure(
+    w, GTK_ORIENTATION_HORIZONTAL, -1, NULL, &cell_w, NULL, NULL
+  );
+  gtk_widget_measure(
+    w, GTK_ORIENTATION_VERTICAL, cell_w, NULL, &cell_h, NULL, NULL
+  );
+
+  if (cell_w == card->mixer_cell_w && cell_h == card->mixer_cell_h)
+    return;
+
+  card->mixer_cell_w = cell_w;
+  card->mixer_cell_h = cell_h;
+
+  for (GList *l = card->mixer_gain_widgets; l; l = l->next) {
+    struct mixer_gain_widget *mg = l->data;
+
+    gtk_widget_set_size_request(mg->cell, cell_w, cell_h);
+  }
+}
+
+// Create the gain widget for a mixer cell
+static void realise_mixer_gain_widget(struct mixer_gain_widget *mg) {
+  GtkWidget *w;
+
+  if (mg->widget)
+    return;
+
+  if (mg->elem_count == 1)
+    w = make_gain_alsa_elem(
+      mg->elems[0], 1, WIDGET_GAIN_TAPER_LOG, 0, TRUE
+    );
+  else
+    w = make_stereo_gain_alsa_elem(
+      mg->elems, mg->elem_count, 1,
+      WIDGET_GAIN_TAPER_LOG, 0, TRUE
+    );
+
+  if (!w)
+    return;
+
+  gtk_box_append(GTK_BOX(mg->cell), w);
+  mg->widget = w;
+}
+
+// Destroy the gain widget of a mixer cell, leaving the empty cell
+static void release_mixer_gain_widget(struct mixer_gain_widget *mg) {
+  if (!mg->widget)
+    return;
+
+  cleanup_gain_widget(mg->widget);
+  gtk_box_remove(GTK_BOX(mg->cell), mg->widget);
+  mg->widget = NULL;
+}
+
+// Check if bounds are within margin of the (0, 0, view_w, view_h)
+// viewport
+static gboolean bounds_near_view(
+  const graphene_rect_t *bounds,
+  int                    view_w,
+  int                    view_h,
+  double                 margin_x,
+  double                 margin_y
+) {
+  return bounds->origin.x + bounds->size.width > -margin_x &&
+         bounds->origin.x < view_w + margin_x &&
+         bounds->origin.y + bounds->size.height > -margin_y &&
+         bounds->origin.y < view_h + margin_y;
+}
+
+// Create gain widgets for cells that are within one cell of the
+// visible part of the mixer window, and destroy those that are
+// more than a page away, so the number of live dials follows the
+// window size rather than the mixer size
+static gboolean sync_mixer_gain_cells(gpointer user_data) {
+  struct alsa_card *card = user_data;
+
+  card->mixer_cells_idle = 0;
+
+  if (!card->mixer_grid || !gtk_widget_get_mapped(card->mixer_grid))
+    return G_SOURCE_REMOVE;
+
+  GtkWidget *view = gtk_widget_get_ancestor(
+    card->mixer_grid, GTK_TYPE_SCROLLED_WINDOW
+  );
+  if (!view)
+    view = card->mixer_grid;
+
+  int view_w = gtk_widget_get_width(view);
+  int view_h = gtk_widget_get_height(view);
+  GtkWidget *first_realised = NULL;
+
+  for (GList *l = card->mixer_gain_widgets; l; l = l->next) {
+    struct mixer_gain_widget *mg = l->data;
+    graphene_rect_t bounds;
+
+    int attached = gtk_widget_get_parent(mg->cell) == card->mixer_grid;
+
+    if (!attached ||
+        !gtk_widget_compute_bounds(mg->cell, view, &bounds)) {
+      release_mixer_gain_widget(mg);
+      continue;
+    }
+
+    if (bounds_near_view(
+          &bounds, view_w, view_h,
+          card->mixer_cell_w, card->mixer_cell_h
+        )) {
+      realise_mixer_gain_widget(mg);
+      if (!first_realised)
+        first_realised = mg->widget;
+    } else if (!bounds_near_view(
+                 &bounds, view_w, view_h, view_w, view_h
+               )) {
+      release_mixer_gain_widget(mg);
+    }
+  }
+
+  // the size measured before the window was shown may not have had
+  // the final styling applied
+  if (first_realised)
+    update_mixer_cell_size(card, first_realised);
+
+  return G_SOURCE_REMOVE;
+}
+
+// Schedule a sync of the realised mixer cells for when the main loop
+// is idle; changing children during size allocation isn't allowed
+static void queue_mixer_cell_sync(struct alsa_card *card) {
+  if (!card->mixer_cells_idle)
+    card->mixer_cells_idle = g_idle_add(sync_mixer_gain_cells, card);
+}
+
+static void mixer_scrolled(GtkAdjustment *adj, struct alsa_card *card) {
+  queue_mixer_cell_sync(card);
+}
+
+// Once the grid is in its scrolled window, follow the scroll
+// position and viewport size
+static void mixer_grid_mapped(GtkWidget *grid, struct alsa_card *card) {
+  GtkWidget *view = gtk_widget_get_ancestor(
+    grid, GTK_TYPE_SCROLLED_WINDOW
+  );
+
+  if (view && !g_object_get_data(G_OBJECT(view), "mixer_cells")) {
+    GtkScrolledWindow *sw = GTK_SCROLLED_WINDOW(view);
+    GtkAdjustment *adjs[] = {
+      gtk_scrolled_window_get_hadjustment(sw),
+      gtk_scrolled_window_get_vadjustment(sw)
+    };
+
+    for (int i = 0; i < 2; i++) {
+      g_signal_connect(
+        adjs[i], "value-changed", G_CALLBACK(mixer_scrolled), card
+      );
+      g_signal_connect(
+        adjs[i], "changed", G_CALLBACK(mixer_scrolled), card
+      );
+    }
+    g_object_set_data(G_OBJECT(view), "mixer_cells", card);
+  }
+
+  queue_mixer_cell_sync(card);
+}
+
+// Free a mixer gain widget entry, removing its cell from the grid
+static void free_mixer_gain_widget(struct mixer_gain_widget *mg) {
+  GtkWidget *parent = gtk_widget_get_parent(mg->cell);
+
+  release_mixer_gain_widget(mg);
+  if (parent)
+    gtk_grid_remove(GTK_GRID(parent), mg->cell);
+  g_object_unref(mg->cell);
+  g_free(mg);
+}
+
+// Create the mixer gain cells for the current stereo link state.
+// Entries in reuse that control the same elements at the same
+// position are moved to card->mixer_gain_widgets instead of being
+// recreated; the caller frees whatever is left in reuse.
+static void populate_mixer_gain_widgets(
+  struct alsa_card        *card,
+  struct mixer_gain_reuse *reuse
+) {
   int num_mixes = card->routing_in_count[PC_MIX];
   int num_inputs = card->routing_out_count[PC_MIX];
 
@@ -974,28 +1195,30 @@ static void populate_mixer_gain_widgets(struct alsa_card *card) {
       if (elem_count == 0)
         continue;
 
-      // Create the gain widget
-      GtkWidget *w;
-      if (elem_count == 1) {
-        w = make_gain_alsa_elem(
-          elem_arr[0], 1, WIDGET_GAIN_TAPER_LOG, 0, TRUE
-        );
-      } else {
-        w = make_stereo_gain_alsa_elem(
-          elem_arr, elem_count, 1,
-          WIDGET_GAIN_TAPER_LOG, 0, TRUE
-        );
+      struct mixer_gain_widget *old_mg = take_reusable_gain_widget(
+        reuse, mix_num, input_num, elem_arr, elem_count
+      );
+      if (old_mg) {
+        card->mixer_gain_widgets =
+          g_list_prepend(card->mixer_gain_widgets, old_mg);
+        continue;
       }
 
-      if (!w)
-        continue;
+      // Create the cell; the gain widget inside it is created when
+      // the cell scrolls into view
+      GtkWidget *cell = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
+      gtk_widget_set_vexpand(cell, TRUE);
+      if (card->mixer_cell_w)
+        gtk_widget_set_size_request(
+          cell, card->mixer_cell_w, card->mixer_cell_h
+        );
 
       // keep alive when removed from grid
-      g_object_ref(w);
+      g_object_ref(cell);
 
       struct mixer_gain_widget *mg =
         g_malloc0(sizeof(struct mixer_gain_widget));
-      mg->widget = w;
+      mg->cell = cell;
       mg->mix_num = mix_num;
       mg->input_num = input_num;
       mg->r_snk = r_snk;
@@ -1017,23 +1240,23 @@ static void populate_mixer_gain_widgets(struct alsa_card *card) {
 
       // Store label references for hover effect
       g_object_set_data(
-        G_OBJECT(w), "mix_label_left",
+        G_OBJECT(cell), "mix_label_left",
         mix_src->mixer_label_left
       );
       g_object_set_data(
-        G_OBJECT(w), "mix_label_right",
+        G_OBJECT(cell), "mix_label_right",
         mix_src->mixer_label_right
       );
       g_object_set_data(
-        G_OBJECT(w), "source_label_top",
+        G_OBJECT(cell), "source_label_top",
         r_snk->mixer_label_top
       );
       g_object_set_data(
-        G_OBJECT(w), "source_label_bottom",
+        G_OBJECT(cell), "source_label_bottom",
         r_snk->mixer_label_bottom
       );
 
-      add_mixer_hover_controller(w);
+      add_mixer_hover_controller(cell);
     }
   }
 
@@ -1046,15 +1269,9 @@ GtkWidget *create_mixer_controls(struct alsa_card *card) {
   gtk_widget_add_css_class(top, "window-frame");
 
   // clear any existing mixer gain widgets from previous window
-  for (GList *l = card->mixer_gain_widgets; l != NULL; l = l->next) {
-    struct mixer_gain_widget *mg = l->data;
-    if (mg->widget) {
-      cleanup_gain_widget(mg->widget);
-      g_object_unref(mg->widget);
-    }
-    g_free(mg);
-  }
-  g_list_free(card->mixer_gain_widgets);
+  g_list_free_full(
+    card->mixer_gain_widgets, (GDestroyNotify)free_mixer_gain_widget
+  );
   card->mixer_gain_widgets = NULL;
 
   // create overlay to hold the grid and glow layer
@@ -1085,6 +1302,11 @@ GtkWidget *create_mixer_controls(struct alsa_card *card) {
   // store the grid for later access
   card->mixer_grid = mixer_top;
 
+  // gain widgets are only created for cells in view
+  g_signal_connect(
+    mixer_top, "map", G_CALLBACK(mixer_grid_mapped), card
+  );
+
   // create drawing area for glow effects as underlay
   // use measure callback to not affect sizing
   card->mixer_glow = gtk_drawing_area_new();
@@ -1191,7 +1413,17 @@ GtkWidget *create_mixer_controls(struct alsa_card *card) {
     }
   }
 
-  populate_mixer_gain_widgets(card);
+  populate_mixer_gain_widgets(card, NULL);
+
+  // measure a gain widget so the cells have the right size before
+  // the window is first shown
+  if (card->mixer_gain_widgets) {
+    struct mixer_gain_widget *mg = card->mixer_gain_widgets->data;
+
+    realise_mixer_gain_widget(mg);
+    if (mg->widget)
+      update_mixer_cell_size(card, mg->widget);
+  }
 
   update_mixer_labels(card);
 
@@ -1243,54 +1475,95 @@ void update_mixer_labels(struct alsa_card *card) {
     struct routing_snk *r_snk = &g_array_index(
       card->routing_snks, struct routing_snk, i
     );
-    struct alsa_elem *elem = r_snk->elem;
 
-    if (elem->port_category != PC_MIX)
-      continue;
+    update_mixer_input_label(card, r_snk);
+  }
+}
 
-    // Skip R channel of linked pair (label handled by L channel)
-    if (!should_display_snk(r_snk))
-      continue;
+void update_mixer_input_label(
+  struct alsa_card   *card,
+  struct routing_snk *r_snk
+) {
+  struct alsa_elem *elem = r_snk->elem;
 
-    int routing_src_idx = alsa_get_elem_value(elem);
+  if (elem->port_category != PC_MIX)
+    return;
 
-    struct routing_src *r_src = &g_array_index(
-      card->routing_srcs, struct routing_src, routing_src_idx
-    );
+  // Skip R channel of linked pair (label handled by L channel)
+  if (!should_display_snk(r_snk))
+    return;
 
-    if (r_snk->mixer_label_top) {
-      char *display_name;
+  if (!r_snk->mixer_label_top)
+    return;
 
-      // If this mixer input is linked and the connected source is also linked,
-      // show the stereo pair name
-      if (is_snk_linked(r_snk) && is_src_linked(r_src)) {
-        display_name = get_src_pair_display_name(r_src);
-      } else {
-        display_name = g_strdup(get_routing_src_display_name(r_src));
-      }
+  int routing_src_idx = alsa_get_elem_value(elem);
 
-      set_rotated_label_text(r_snk->mixer_label_top, display_name);
-      set_rotated_label_text(r_snk->mixer_label_bottom, display_name);
-      g_free(display_name);
-    }
+  struct routing_src *r_src = &g_array_index(
+    card->routing_srcs, struct routing_src, routing_src_idx
+  );
+
+  char *display_name;
+
+  // If this mixer input is linked and the connected source is also linked,
+  // show the stereo pair name
+  if (is_snk_linked(r_snk) && is_src_linked(r_src)) {
+    display_name = get_src_pair_display_name(r_src);
+  } else {
+    display_name = g_strdup(get_routing_src_display_name(r_src));
   }
+
+  set_rotated_label_text(r_snk->mixer_label_top, display_name);
+  set_rotated_label_text(r_snk->mixer_label_bottom, display_name);
+  g_free(display_name);
 }
 
-// Rebuild the mixer grid layout based on current port enable states
+// Place a child of the mixer grid at (col, row), or remove it from
+// the grid if col or row is -1. Children already in the right cell
+// are left alone, and children in the wrong cell are moved without
+// being unparented, so only the changed rows/columns are touched.
+static void place_in_mixer_grid(
+  GtkGrid   *grid,
+  GtkWidget *child,
+  int        col,
+  int        row
+) {
+  if (!child)
+    return;
+
+  int attached = gtk_widget_get_parent(child) == GTK_WIDGET(grid);
+
+  if (col < 0 || row < 0) {
+    if (attached)
+      gtk_grid_remove(grid, child);
+    return;
+  }
+
+  if (!attached) {
+    gtk_grid_attach(grid, child, col, row, 1, 1);
+    return;
+  }
+
+  int cur_col, cur_row, width, height;
+  gtk_grid_query_child(grid, child, &cur_col, &cur_row, &width, &height);
+  if (cur_col == col && cur_row == row)
+    return;
+
+  GtkLayoutManager *layout =
+    gtk_widget_get_layout_manager(GTK_WIDGET(grid));
+  GtkGridLayoutChild *layout_child = GTK_GRID_LAYOUT_CHILD(
+    gtk_layout_manager_get_layout_child(layout, child)
+  );
+  gtk_grid_layout_child_set_column(layout_child, col);
+  gtk_grid_layout_child_set_row(layout_child, row);
+}
+
+// Update the mixer grid layout based on current port enable states
 void rebuild_mixer_grid(struct alsa_card *card) {
   if (!card || !card->mixer_grid)
     return;
 
   GtkGrid *grid = GTK_GRID(card->mixer_grid);
 
-  // Remove all widgets from the grid (but keep references)
-  GtkWidget *child = gtk_widget_get_first_child(GTK_WIDGET(grid));
-  while (child) {
-    GtkWidget *next = gtk_widget_get_next_sibling(child);
-    gtk_grid_remove(grid, child);
-    child = next;
-  }
-
   // Build list of visible mixer outputs (sources)
   int visible_mix_count = 0;
   int mix_num_to_row[MAX_MIX_OUT];  // map mix_num to row
@@ -1354,8 +1627,9 @@ void rebuild_mixer_grid(struct alsa_card *card) {
     }
   }
 
-  // Re-attach mixer output labels (left and right)
+  // Place mixer output labels (left and right)
   int row_offset = 1;  // row 0 is for rotated input labels
+  int show_br = card->pref_show_bottom_right_labels;
   for (int i = 0; i < card->routing_srcs->len; i++) {
     struct routing_src *src = &g_array_index(
       card->routing_srcs, struct routing_src, i
@@ -1365,34 +1639,23 @@ void rebuild_mixer_grid(struct alsa_card *card) {
       continue;
 
     // bounds check
-    if (src->port_num < 0 || src->port_num >= MAX_MIX_OUT)
-      continue;
-
-    int row = mix_num_to_row[src->port_num];
-    if (row < 0)  // not visible
-      continue;
-
-    if (src->mixer_label_left) {
-      gtk_grid_attach(
-        grid, src->mixer_label_left,
-        0, row + row_offset, 1, 1
-      );
-    }
+    int row = src->port_num >= 0 && src->port_num < MAX_MIX_OUT
+      ? mix_num_to_row[src->port_num] : -1;
 
-    if (src->mixer_label_right && card->pref_show_bottom_right_labels) {
-      gtk_grid_attach(
-        grid, src->mixer_label_right,
-        visible_input_count + 1, row + row_offset, 1, 1
-      );
-    }
+    place_in_mixer_grid(
+      grid, src->mixer_label_left,
+      0, row < 0 ? -1 : row + row_offset
+    );
+    place_in_mixer_grid(
+      grid, src->mixer_label_right,
+      visible_input_count + 1, row < 0 || !show_br ? -1 : row + row_offset
+    );
   }
 
-  // Attach corner label
-  if (card->mixer_corner_label) {
-    gtk_grid_attach(grid, card->mixer_corner_label, 0, 0, 1, 1);
-  }
+  // Place corner label
+  place_in_mixer_grid(grid, card->mixer_corner_label, 0, 0);
 
-  // Re-attach mixer input labels (top and bottom)
+  // Place mixer input labels (top and bottom)
   for (int i = 0; i < card->routing_snks->len; i++) {
     struct routing_snk *snk = &g_array_index(
       card->routing_snks, struct routing_snk, i
@@ -1404,47 +1667,37 @@ void rebuild_mixer_grid(struct alsa_card *card) {
     int input_num = snk->elem->lr_num - 1;
 
     // bounds check
-    if (input_num < 0 || input_num >= max_mixer_inputs)
-      continue;
-
-    int col = input_num_to_col[input_num];
-    if (col < 0)  // not visible
-      continue;
-
-    if (snk->mixer_label_top) {
-      gtk_grid_attach(
-        grid, snk->mixer_label_top,
-        col + 1, 0, 1, 1
-      );
-    }
+    int col = input_num >= 0 && input_num < max_mixer_inputs
+      ? input_num_to_col[input_num] : -1;
 
-    if (snk->mixer_label_bottom && card->pref_show_bottom_right_labels) {
-      gtk_grid_attach(
-        grid, snk->mixer_label_bottom,
-        col + 1, visible_mix_count + row_offset, 1, 1
-      );
-    }
+    place_in_mixer_grid(
+      grid, snk->mixer_label_top,
+      col < 0 ? -1 : col + 1, 0
+    );
+    place_in_mixer_grid(
+      grid, snk->mixer_label_bottom,
+      col < 0 || !show_br ? -1 : col + 1, visible_mix_count + row_offset
+    );
   }
 
-  // Re-attach gain widgets
+  // Place gain cells
   for (GList *l = card->mixer_gain_widgets; l != NULL; l = l->next) {
     struct mixer_gain_widget *mg = l->data;
 
-    // bounds check before accessing arrays
-    if (mg->mix_num < 0 || mg->mix_num >= MAX_MIX_OUT ||
-        mg->input_num < 0 || mg->input_num >= max_mixer_inputs)
-      continue;
+    int row = -1, col = -1;
 
-    int row = mix_num_to_row[mg->mix_num];
-    int col = input_num_to_col[mg->input_num];
+    // bounds check before accessing arrays
+    if (mg->mix_num >= 0 && mg->mix_num < MAX_MIX_OUT &&
+        mg->input_num >= 0 && mg->input_num < max_mixer_inputs) {
+      row = mix_num_to_row[mg->mix_num];
+      col = input_num_to_col[mg->input_num];
+    }
 
     // Only attach if both mixer output and input are visible
-    if (row >= 0 && col >= 0) {
-      gtk_grid_attach(
-        grid, mg->widget,
-        col + 1, row + row_offset, 1, 1
-      );
-    }
+    if (row >= 0 && col >= 0)
+      place_in_mixer_grid(grid, mg->cell, col + 1, row + row_offset);
+    else
+      place_in_mixer_grid(grid, mg->cell, -1, -1);
   }
 
   // when bottom/right labels are hidden, add a spacer to the right
@@ -1483,19 +1736,24 @@ void rebuild_mixer_grid(struct alsa_card *card) {
     gtk_widget_set_size_request(
       card->mixer_right_spacer, spacer_w, 1
     );
-    gtk_grid_attach(
+    place_in_mixer_grid(
       grid, card->mixer_right_spacer,
-      visible_input_count + 1, 0, 1, 1
+      visible_input_count + 1, 0
     );
+  } else {
+    place_in_mixer_grid(grid, card->mixer_right_spacer, -1, -1);
   }
 
-  // force full relayout and redraw of overlay drawing areas
+  // force relayout and redraw of overlay drawing areas
   if (card->mixer_overlay)
     gtk_widget_queue_resize(card->mixer_overlay);
   if (card->mixer_label_overlay)
     gtk_widget_queue_draw(card->mixer_label_overlay);
   if (card->mixer_glow)
     gtk_widget_queue_draw(card->mixer_glow);
+
+  // cells may have moved into or out of view
+  queue_mixer_cell_sync(card);
 }
 
 // Update mixer window availability indication
@@ -1510,28 +1768,31 @@ void update_mixer_availability(struct alsa_card *card, int available) {
 }
 
 // Recreate mixer widgets when stereo state changes
-// This destroys existing widgets and creates new ones based on current stereo
+// Widgets whose elements are unchanged are kept; the others are
+// destroyed and new ones created based on current stereo state
 void recreate_mixer_widgets(struct alsa_card *card) {
   if (!card || !card->mixer_grid)
     return;
 
-  GtkGrid *grid = GTK_GRID(card->mixer_grid);
+  // index the current widgets by position (one per cell)
+  struct mixer_gain_reuse *reuse = g_malloc0(sizeof(struct mixer_gain_reuse));
 
-  // Clear existing mixer gain widgets
-  for (GList *l = card->mixer_gain_widgets; l != NULL; l = l->next) {
+  for (GList *l = card->mixer_gain_widgets; l; l = l->next) {
     struct mixer_gain_widget *mg = l->data;
-    if (mg->widget) {
-      if (gtk_widget_get_parent(mg->widget) == GTK_WIDGET(grid))
-        gtk_grid_remove(grid, mg->widget);
-      cleanup_gain_widget(mg->widget);
-      g_object_unref(mg->widget);
-    }
-    g_free(mg);
+
+    reuse->cells[mg->mix_num][mg->input_num] = mg;
   }
   g_list_free(card->mixer_gain_widgets);
   card->mixer_gain_widgets = NULL;
 
-  populate_mixer_gain_widgets(card);
+  populate_mixer_gain_widgets(card, reuse);
+
+  // Clear mixer gain widgets that weren't reused
+  for (int mix_num = 0; mix_num < MAX_MIX_OUT; mix_num++)
+    for (int input_num = 0; input_num < MAX_MUX_IN; input_num++)
+      if (reuse->cells[mix_num][input_num])
+        free_mixer_gain_widget(reuse->cells[mix_num][input_num]);
+  g_free(reuse);
 
   update_mixer_labels(card);
   rebuild_mixer_grid(card);
@@ -6,8 +6,11 @@
 #include "alsa.h"
 
 // Structure to store mixer gain widget and its coordinates
+// The cell is always present in the mixer grid; the gain widget
+// inside it is only created while the cell is on-screen
 struct mixer_gain_widget {
-  GtkWidget *widget;
+  GtkWidget *cell;           // grid child holding the gain widget
+  GtkWidget *widget;         // gain widget, or NULL if not realised
   int mix_num;               // 0-based mix number (A=0, B=1, etc.)
   int input_num;             // 0-based input number
   struct routing_snk *r_snk; // routing sink for this input (for level lookup)
@@ -22,6 +25,12 @@ struct mixer_gain_widget {
 
 GtkWidget *create_mixer_controls(struct alsa_card *card);
 void update_mixer_labels(struct alsa_card *card);
+
+// Update the labels of one mixer input after its source changes
+void update_mixer_input_label(
+  struct alsa_card   *card,
+  struct routing_snk *r_snk
+);
 void rebuild_mixer_grid(struct alsa_card *card);
 void update_mixer_availability(struct alsa_card *card, int available);
 
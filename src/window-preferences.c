@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "optional-state.h"
+#include "window-helper.h"
 #include "window-levels.h"
 #include "window-mixer.h"
 #include "window-preferences.h"
@@ -237,3 +238,24 @@ GtkWidget *create_preferences_controls(
 
   return top;
 }
+
+static gboolean window_preferences_close_request(GtkWindow *w, gpointer data) {
+  struct alsa_card *card = data;
+
+  gtk_widget_activate_action(
+    GTK_WIDGET(card->window_main), "win.preferences", NULL
+  );
+  return true;
+}
+
+GtkWidget *create_preferences_window(struct alsa_card *card) {
+  GtkWidget *w = create_subwindow(
+    card, "Preferences",
+    G_CALLBACK(window_preferences_close_request)
+  );
+
+  GtkWidget *preferences = create_preferences_controls(card);
+  gtk_window_set_child(GTK_WINDOW(w), preferences);
+
+  return w;
+}
@@ -15,3 +15,6 @@ int levels_hz_to_ms(int hz);
 void load_preferences(struct alsa_card *card);
 
 GtkWidget *create_preferences_controls(struct alsa_card *card);
+
+// Create the Preferences window (not shown)
+GtkWidget *create_preferences_window(struct alsa_card *card);
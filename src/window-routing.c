@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: 2022-2025 Geoffrey D. Bennett <g@b4.vu>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include "debug.h"
 #include "gtkhelper.h"
+#include "hit-grid.h"
 #include "hw-io-availability.h"
 #include "iface-mixer.h"
 #include "routing-drag-line.h"
+#include "routing-graph.h"
 #include "routing-lines.h"
 #include "stereo-link.h"
 #include "stringhelper.h"
@@ -15,18 +18,14 @@
 #include "port-enable.h"
 
 // clear all the routing sinks
-static void routing_preset_clear(struct alsa_card *card) {
-  for (int i = 0; i < card->routing_snks->len; i++) {
-    struct routing_snk *r_snk = &g_array_index(
-      card->routing_snks, struct routing_snk, i
-    );
-
-    alsa_set_elem_value(r_snk->elem, 0);
-  }
+static void routing_preset_clear(struct alsa_card *card, int *targets) {
+  for (int i = 0; i < card->routing_snks->len; i++)
+    targets[i] = 0;
 }
 
 static void routing_preset_link(
   struct alsa_card *card,
+  int              *targets,
   int               src_port_category,
   int               src_mod,
   int               snk_port_category
@@ -81,8 +80,8 @@ static void routing_preset_link(
     if (elem->port_category != snk_port_category)
       break;
 
-    // do the assignment
-    alsa_set_elem_value(elem, r_src->id);
+    // record the assignment
+    targets[snk_idx] = r_src->id;
 
     // get the next index
     src_idx++;
@@ -96,17 +95,59 @@ static void routing_preset_link(
   }
 }
 
-static void routing_preset_direct(struct alsa_card *card) {
-  routing_preset_link(card, PC_HW, 0, PC_PCM);
-  routing_preset_link(card, PC_PCM, 0, PC_HW);
+static void routing_preset_direct(struct alsa_card *card, int *targets) {
+  routing_preset_link(card, targets, PC_HW, 0, PC_PCM);
+  routing_preset_link(card, targets, PC_PCM, 0, PC_HW);
 }
 
-static void routing_preset_preamp(struct alsa_card *card) {
-  routing_preset_link(card, PC_HW, 0, PC_HW);
+static void routing_preset_preamp(struct alsa_card *card, int *targets) {
+  routing_preset_link(card, targets, PC_HW, 0, PC_HW);
 }
 
-static void routing_preset_stereo_out(struct alsa_card *card) {
-  routing_preset_link(card, PC_PCM, 2, PC_HW);
+static void routing_preset_stereo_out(struct alsa_card *card, int *targets) {
+  routing_preset_link(card, targets, PC_PCM, 2, PC_HW);
+}
+
+// Write the target source of each sink, skipping the sinks that
+// already have it. The routing UI updates from the resulting element
+// changes are deferred to a single update at idle.
+static void routing_preset_apply(struct alsa_card *card, int *targets) {
+  int written = 0;
+  int skipped = 0;
+
+  card->routing_ui_update_deferred = TRUE;
+
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+
+    if (alsa_get_elem_value(r_snk->elem) == targets[i]) {
+      skipped++;
+      continue;
+    }
+
+    alsa_set_elem_value(r_snk->elem, targets[i]);
+    written++;
+  }
+
+  schedule_ui_update(card, PENDING_UI_UPDATE_ROUTING);
+
+  if (debug_enabled("routing-preset"))
+    printf(
+      "ROUTING-PRESET: %d sinks written, %d unchanged skipped\n",
+      written, skipped
+    );
+}
+
+// Flush the routing UI updates deferred by routing_preset_apply()
+void flush_routing_ui_update(struct alsa_card *card) {
+  card->routing_ui_update_deferred = FALSE;
+
+  update_mixer_labels(card);
+
+  if (card->routing_lines)
+    gtk_widget_queue_draw(card->routing_lines);
 }
 
 static void routing_preset(
@@ -116,15 +157,29 @@ static void routing_preset(
 ) {
   const char *s = g_variant_get_string(value, NULL);
 
+  // start from the current routing so that sinks a preset doesn't
+  // touch are left alone
+  int *targets = g_malloc(card->routing_snks->len * sizeof(int));
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+
+    targets[i] = alsa_get_elem_value(r_snk->elem);
+  }
+
   if (strcmp(s, "clear") == 0) {
-    routing_preset_clear(card);
+    routing_preset_clear(card, targets);
   } else if (strcmp(s, "direct") == 0) {
-    routing_preset_direct(card);
+    routing_preset_direct(card, targets);
   } else if (strcmp(s, "preamp") == 0) {
-    routing_preset_preamp(card);
+    routing_preset_preamp(card, targets);
   } else if (strcmp(s, "stereo_out") == 0) {
-    routing_preset_stereo_out(card);
+    routing_preset_stereo_out(card, targets);
   }
+
+  routing_preset_apply(card, targets);
+  g_free(targets);
 }
 
 static GtkWidget *make_preset_menu_button(struct alsa_card *card) {
@@ -480,12 +535,15 @@ static int is_horiz_port_category(int port_category) {
   return port_category == PC_MIX || port_category == PC_DSP;
 }
 
+static void routing_hit_index_free(struct alsa_card *card);
+
 // Release refs held on routing widgets.
 // Called before the routing window is destroyed.
 void cleanup_routing_widgets(struct alsa_card *card) {
   // Clear hover state to prevent dangling pointers
   card->hovered_src = NULL;
   card->hovered_snk = NULL;
+  routing_hit_index_free(card);
 
   // Clean up source widgets
   if (card->routing_srcs) {
@@ -536,6 +594,8 @@ void arrange_src_grid(struct alsa_card *card, int port_category) {
   if (!grid)
     return;
 
+  routing_hit_index_invalidate(card);
+
   int is_horiz = is_horiz_port_category(port_category);
   int pos = 0;
 
@@ -584,6 +644,8 @@ void arrange_snk_grid(struct alsa_card *card, int port_category) {
   if (port_category == PC_MIX && card->has_fixed_mixer_inputs)
     return;
 
+  routing_hit_index_invalidate(card);
+
   int is_horiz = is_horiz_port_category(port_category);
   int pos = 0;
 
@@ -848,23 +910,101 @@ static void queue_redraw_group_highlights(struct alsa_card *card) {
   }
 }
 
-// Motion handler for overlay-based hover detection
-static void routing_overlay_motion(
-  GtkEventControllerMotion *controller,
-  double                    x,
-  double                    y,
-  gpointer                  user_data
+// cached hit-test index of the source and sink rectangles, in
+// routing_grid coordinates
+struct routing_hit_index {
+  struct hit_grid srcs;
+  struct hit_grid snks;
+  int             valid;
+
+  // routing_grid size when the index was built
+  int             width;
+  int             height;
+
+  // pending after-paint handler to invalidate again once the
+  // widgets have been reallocated
+  GdkFrameClock  *clock;
+  gulong          after_paint_id;
+};
+
+static void routing_hit_index_after_paint(
+  GdkFrameClock *clock,
+  gpointer       user_data
 ) {
   struct alsa_card *card = user_data;
-  GtkWidget *overlay = gtk_event_controller_get_widget(
-    GTK_EVENT_CONTROLLER(controller)
+  struct routing_hit_index *index = card->routing_hit_index;
+
+  index->valid = 0;
+  g_signal_handler_disconnect(clock, index->after_paint_id);
+  index->after_paint_id = 0;
+  index->clock = NULL;
+}
+
+// Mark the hit-test index stale after a change that can move or
+// resize the routing sources and sinks (visibility, links, labels).
+// The new allocations only take effect in the next frame, so the
+// index is invalidated again after that frame has been painted.
+void routing_hit_index_invalidate(struct alsa_card *card) {
+  struct routing_hit_index *index = card->routing_hit_index;
+
+  if (!index)
+    return;
+
+  index->valid = 0;
+
+  if (index->after_paint_id || !card->routing_grid)
+    return;
+
+  GdkFrameClock *clock = gtk_widget_get_frame_clock(card->routing_grid);
+  if (!clock)
+    return;
+
+  index->clock = clock;
+  index->after_paint_id = g_signal_connect(
+    clock, "after-paint", G_CALLBACK(routing_hit_index_after_paint), card
   );
+}
 
-  struct routing_src *new_hovered_src = NULL;
-  struct routing_snk *new_hovered_snk = NULL;
-  graphene_point_t point = GRAPHENE_POINT_INIT(x, y);
+static void routing_hit_index_free(struct alsa_card *card) {
+  struct routing_hit_index *index = card->routing_hit_index;
+
+  if (!index)
+    return;
 
-  // Check sources (skip "Off" at index 0)
+  if (index->after_paint_id)
+    g_signal_handler_disconnect(index->clock, index->after_paint_id);
+  hit_grid_free(&index->srcs);
+  hit_grid_free(&index->snks);
+  g_free(index);
+
+  card->routing_hit_index = NULL;
+}
+
+static void add_hit_rect(
+  struct hit_grid *grid,
+  graphene_rect_t *bounds,
+  void            *data
+) {
+  hit_grid_add(
+    grid,
+    graphene_rect_get_x(bounds),
+    graphene_rect_get_y(bounds),
+    graphene_rect_get_width(bounds),
+    graphene_rect_get_height(bounds),
+    data
+  );
+}
+
+static void build_routing_hit_index(
+  struct alsa_card         *card,
+  struct routing_hit_index *index
+) {
+  GtkWidget *grid = card->routing_grid;
+
+  hit_grid_clear(&index->srcs);
+  hit_grid_clear(&index->snks);
+
+  // Sources (skip "Off" at index 0)
   for (int i = 1; i < card->routing_srcs->len; i++) {
     struct routing_src *src = &g_array_index(
       card->routing_srcs, struct routing_src, i
@@ -878,72 +1018,82 @@ static void routing_overlay_motion(
       continue;
 
     graphene_rect_t bounds;
-    if (!get_src_bounds_relative(src, overlay, &bounds))
+    if (get_src_bounds_relative(src, grid, &bounds))
+      add_hit_rect(&index->srcs, &bounds, src);
+  }
+
+  // Sinks
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+
+    if (!is_routing_snk_enabled(snk))
       continue;
 
-    if (graphene_rect_contains_point(&bounds, &point)) {
-      new_hovered_src = src;
-      break;
-    }
+    // For linked pairs, only hit-test the left channel
+    if (is_snk_linked(snk) && !is_snk_left_channel(snk))
+      continue;
+
+    graphene_rect_t bounds;
+    if (get_snk_bounds_relative(snk, grid, &bounds))
+      add_hit_rect(&index->snks, &bounds, snk);
   }
 
-  // Check sinks if no source was hit
-  if (!new_hovered_src) {
-    for (int i = 0; i < card->routing_snks->len; i++) {
-      struct routing_snk *snk = &g_array_index(
-        card->routing_snks, struct routing_snk, i
-      );
+  hit_grid_build(&index->srcs);
+  hit_grid_build(&index->snks);
 
-      if (!is_routing_snk_enabled(snk))
-        continue;
+  index->width = gtk_widget_get_width(grid);
+  index->height = gtk_widget_get_height(grid);
+  index->valid = 1;
 
-      // For linked pairs, only hit-test the left channel
-      if (is_snk_linked(snk) && !is_snk_left_channel(snk))
-        continue;
+  if (debug_enabled("routing-hit"))
+    printf(
+      "ROUTING-HIT: rebuilt index: %d sources, %d sinks, %dx%d\n",
+      index->srcs.count, index->snks.count, index->width, index->height
+    );
+}
 
-      graphene_rect_t bounds;
-      if (!get_snk_bounds_relative(snk, overlay, &bounds))
-        continue;
+// Get the hit-test index, rebuilding it if it is stale
+static struct routing_hit_index *get_routing_hit_index(
+  struct alsa_card *card
+) {
+  struct routing_hit_index *index = card->routing_hit_index;
 
-      if (graphene_rect_contains_point(&bounds, &point)) {
-        new_hovered_snk = snk;
-        break;
-      }
-    }
+  if (!index) {
+    index = g_malloc0(sizeof(struct routing_hit_index));
+    hit_grid_init(&index->srcs);
+    hit_grid_init(&index->snks);
+    card->routing_hit_index = index;
   }
 
-  // Update hover state if changed
-  if (new_hovered_src != card->hovered_src ||
-      new_hovered_snk != card->hovered_snk) {
-    card->hovered_src = new_hovered_src;
-    card->hovered_snk = new_hovered_snk;
-    queue_redraw_group_highlights(card);
-    gtk_widget_queue_draw(card->routing_lines);
-  }
+  if (!index->valid ||
+      index->width != gtk_widget_get_width(card->routing_grid) ||
+      index->height != gtk_widget_get_height(card->routing_grid))
+    build_routing_hit_index(card, index);
+
+  return index;
 }
 
-// Leave handler for overlay-based hover detection
-static void routing_overlay_leave(
-  GtkEventControllerMotion *controller,
-  gpointer                  user_data
+// Convert a point to routing_grid coordinates for the hit-test index
+static int get_routing_grid_point(
+  struct alsa_card *card,
+  GtkWidget        *relative_to,
+  double            x,
+  double            y,
+  graphene_point_t *point
 ) {
-  struct alsa_card *card = user_data;
+  graphene_point_t src = GRAPHENE_POINT_INIT(x, y);
 
-  if (card->hovered_src || card->hovered_snk) {
-    card->hovered_src = NULL;
-    card->hovered_snk = NULL;
-    queue_redraw_group_highlights(card);
-    gtk_widget_queue_draw(card->routing_lines);
+  if (relative_to == card->routing_grid) {
+    *point = src;
+    return 1;
   }
-}
 
-// Forward declarations for functions used by unified handlers
-static struct alsa_elem *get_snk_routing_elem(struct routing_snk *r_snk);
-static void route_src_to_snk(
-  struct alsa_card   *card,
-  struct routing_snk *r_snk,
-  int                 src_id
-);
+  return gtk_widget_compute_point(
+    relative_to, card->routing_grid, &src, point
+  );
+}
 
 // Find routing source at point (returns NULL if none)
 static struct routing_src *find_src_at_point(
@@ -952,28 +1102,14 @@ static struct routing_src *find_src_at_point(
   double            x,
   double            y
 ) {
-  graphene_point_t point = GRAPHENE_POINT_INIT(x, y);
+  graphene_point_t point;
 
-  for (int i = 1; i < card->routing_srcs->len; i++) {
-    struct routing_src *src = &g_array_index(
-      card->routing_srcs, struct routing_src, i
-    );
-
-    if (!is_routing_src_enabled(src) || !src->widget2)
-      continue;
-
-    if (is_src_linked(src) && !is_src_left_channel(src))
-      continue;
-
-    graphene_rect_t bounds;
-    if (!get_src_bounds_relative(src, relative_to, &bounds))
-      continue;
+  if (!get_routing_grid_point(card, relative_to, x, y, &point))
+    return NULL;
 
-    if (graphene_rect_contains_point(&bounds, &point))
-      return src;
-  }
+  struct routing_hit_index *index = get_routing_hit_index(card);
 
-  return NULL;
+  return hit_grid_lookup(&index->srcs, point.x, point.y);
 }
 
 // Find routing sink at point (returns NULL if none)
@@ -983,30 +1119,70 @@ static struct routing_snk *find_snk_at_point(
   double            x,
   double            y
 ) {
-  graphene_point_t point = GRAPHENE_POINT_INIT(x, y);
+  graphene_point_t point;
 
-  for (int i = 0; i < card->routing_snks->len; i++) {
-    struct routing_snk *snk = &g_array_index(
-      card->routing_snks, struct routing_snk, i
-    );
+  if (!get_routing_grid_point(card, relative_to, x, y, &point))
+    return NULL;
 
-    if (!is_routing_snk_enabled(snk))
-      continue;
+  struct routing_hit_index *index = get_routing_hit_index(card);
 
-    if (is_snk_linked(snk) && !is_snk_left_channel(snk))
-      continue;
+  return hit_grid_lookup(&index->snks, point.x, point.y);
+}
 
-    graphene_rect_t bounds;
-    if (!get_snk_bounds_relative(snk, relative_to, &bounds))
-      continue;
+// Motion handler for overlay-based hover detection
+static void routing_overlay_motion(
+  GtkEventControllerMotion *controller,
+  double                    x,
+  double                    y,
+  gpointer                  user_data
+) {
+  struct alsa_card *card = user_data;
+  GtkWidget *overlay = gtk_event_controller_get_widget(
+    GTK_EVENT_CONTROLLER(controller)
+  );
+
+  struct routing_src *new_hovered_src = find_src_at_point(
+    card, overlay, x, y
+  );
 
-    if (graphene_rect_contains_point(&bounds, &point))
-      return snk;
+  // Check sinks if no source was hit
+  struct routing_snk *new_hovered_snk = new_hovered_src
+    ? NULL
+    : find_snk_at_point(card, overlay, x, y);
+
+  // Update hover state if changed
+  if (new_hovered_src != card->hovered_src ||
+      new_hovered_snk != card->hovered_snk) {
+    card->hovered_src = new_hovered_src;
+    card->hovered_snk = new_hovered_snk;
+    queue_redraw_group_highlights(card);
+    gtk_widget_queue_draw(card->routing_lines);
   }
+}
 
-  return NULL;
+// Leave handler for overlay-based hover detection
+static void routing_overlay_leave(
+  GtkEventControllerMotion *controller,
+  gpointer                  user_data
+) {
+  struct alsa_card *card = user_data;
+
+  if (card->hovered_src || card->hovered_snk) {
+    card->hovered_src = NULL;
+    card->hovered_snk = NULL;
+    queue_redraw_group_highlights(card);
+    gtk_widget_queue_draw(card->routing_lines);
+  }
 }
 
+// Forward declarations for functions used by unified handlers
+static struct alsa_elem *get_snk_routing_elem(struct routing_snk *r_snk);
+static void route_src_to_snk(
+  struct alsa_card   *card,
+  struct routing_snk *r_snk,
+  int                 src_id
+);
+
 // Callback for stereo link toggle button inside context menu popover
 static void link_popover_clicked(GtkButton *button, gpointer user_data) {
   struct alsa_elem *link_elem = user_data;
@@ -1692,23 +1868,19 @@ static void set_availability_label(
   }
 }
 
-// Update the cached effective source index for a routing sink.
+// Get the effective source index for a routing sink.
 // Uses cached element pointers for performance.
-void update_snk_effective_source(struct routing_snk *r_snk) {
+static int get_snk_effective_source(struct routing_snk *r_snk) {
   struct alsa_elem *elem = r_snk->elem;
   struct alsa_card *card = elem->card;
 
   // Only HW analogue outputs can be affected by speaker switching
-  if (elem->port_category != PC_HW || elem->hw_type != HW_TYPE_ANALOGUE) {
-    r_snk->effective_source_idx = alsa_get_elem_value(elem);
-    return;
-  }
+  if (elem->port_category != PC_HW || elem->hw_type != HW_TYPE_ANALOGUE)
+    return alsa_get_elem_value(elem);
 
   // If no group controls, use normal routing
-  if (!r_snk->main_group_switch && !r_snk->alt_group_switch) {
-    r_snk->effective_source_idx = alsa_get_elem_value(elem);
-    return;
-  }
+  if (!r_snk->main_group_switch && !r_snk->alt_group_switch)
+    return alsa_get_elem_value(elem);
 
   int in_main = r_snk->main_group_switch &&
                 alsa_get_elem_value(r_snk->main_group_switch);
@@ -1716,10 +1888,8 @@ void update_snk_effective_source(struct routing_snk *r_snk) {
                alsa_get_elem_value(r_snk->alt_group_switch);
 
   // If not in either group, use normal routing
-  if (!in_main && !in_alt) {
-    r_snk->effective_source_idx = alsa_get_elem_value(elem);
-    return;
-  }
+  if (!in_main && !in_alt)
+    return alsa_get_elem_value(elem);
 
   int speaker_state = get_speaker_switching_state(card);
 
@@ -1728,31 +1898,32 @@ void update_snk_effective_source(struct routing_snk *r_snk) {
     if (in_main && r_snk->main_group_source) {
       // Main active and in Main group - use Main Group Source
       int vg_idx = alsa_get_elem_value(r_snk->main_group_source);
-      if (vg_idx < card->monitor_group_src_map_count) {
-        r_snk->effective_source_idx = card->monitor_group_src_map[vg_idx];
-        return;
-      }
+      if (vg_idx < card->monitor_group_src_map_count)
+        return card->monitor_group_src_map[vg_idx];
     } else if (in_alt) {
       // Main active but only in Alt group - muted
-      r_snk->effective_source_idx = 0;
-      return;
+      return 0;
     }
   } else if (speaker_state == SPEAKER_SWITCH_ALT) {
     if (in_alt && r_snk->alt_group_source) {
       // Alt active and in Alt group - use Alt Group Source
       int vg_idx = alsa_get_elem_value(r_snk->alt_group_source);
-      if (vg_idx < card->monitor_group_src_map_count) {
-        r_snk->effective_source_idx = card->monitor_group_src_map[vg_idx];
-        return;
-      }
+      if (vg_idx < card->monitor_group_src_map_count)
+        return card->monitor_group_src_map[vg_idx];
     } else if (in_main) {
       // Alt active but only in Main group - muted
-      r_snk->effective_source_idx = 0;
-      return;
+      return 0;
     }
   }
 
-  r_snk->effective_source_idx = alsa_get_elem_value(elem);
+  return alsa_get_elem_value(elem);
+}
+
+// Update the cached effective source index for a routing sink and
+// the source → sinks index.
+// Returns true if the effective source changed.
+int update_snk_effective_source(struct routing_snk *r_snk) {
+  return routing_graph_set_snk_src(r_snk, get_snk_effective_source(r_snk));
 }
 
 // Update hardware output label to show monitor group status
@@ -1763,6 +1934,8 @@ void update_hw_output_label(struct routing_snk *r_snk) {
   if (!r_snk->label_widget)
     return;
 
+  routing_hit_index_invalidate(card);
+
   // Get the display name (stereo-aware, handles custom names)
   char *base_name = get_snk_stereo_aware_name(r_snk);
 
@@ -1904,6 +2077,8 @@ void update_routing_src_label(struct routing_src *r_src) {
   const char *tooltip = NULL;
   struct alsa_card *card = r_src->card;
 
+  routing_hit_index_invalidate(card);
+
   switch (r_src->port_category) {
     case PC_MIX:
       available =
@@ -2016,18 +2191,39 @@ void update_all_hw_io_labels(struct alsa_card *card) {
   update_mixer_headings(card);
 }
 
-// Callback when monitor group related controls change
+// Callback when the speaker switching controls change; every output
+// in a monitor group is affected
 static void monitor_group_changed(struct alsa_elem *elem, void *data) {
   struct alsa_card *card = elem->card;
 
-  // Update all hardware output labels and effective sources
+  int changed = 0;
+
   for (int i = 0; i < card->routing_snks->len; i++) {
     struct routing_snk *r_snk = &g_array_index(
       card->routing_snks, struct routing_snk, i
     );
-    update_snk_effective_source(r_snk);
+    if (!r_snk->main_group_switch && !r_snk->alt_group_switch)
+      continue;
+
+    changed |= update_snk_effective_source(r_snk);
     update_hw_output_label(r_snk);
   }
+
+  if (changed && card->routing_lines)
+    gtk_widget_queue_draw(card->routing_lines);
+}
+
+// Callback when a Main/Alt Group switch or source of one output
+// changes; only that output is affected
+static void monitor_group_snk_changed(struct alsa_elem *elem, void *data) {
+  struct alsa_card *card = elem->card;
+  struct routing_snk *r_snk = data;
+
+  int changed = update_snk_effective_source(r_snk);
+  update_hw_output_label(r_snk);
+
+  if (changed && card->routing_lines)
+    gtk_widget_queue_draw(card->routing_lines);
 }
 
 // Callback when digital I/O mode changes
@@ -2039,10 +2235,22 @@ static void routing_updated(struct alsa_elem *elem, void *data) {
   struct alsa_card *card = elem->card;
   struct routing_snk *r_snk = data;
 
-  if (r_snk)
+  // while a preset is being applied, only keep the effective
+  // source current; the labels and lines are updated once at idle
+  if (card->routing_ui_update_deferred) {
+    if (r_snk)
+      update_snk_effective_source(r_snk);
+    return;
+  }
+
+  // only the label of the mixer input that changed needs updating
+  if (r_snk) {
     update_snk_effective_source(r_snk);
+    update_mixer_input_label(card, r_snk);
+  } else {
+    update_mixer_labels(card);
+  }
 
-  update_mixer_labels(card);
   gtk_widget_queue_draw(card->routing_lines);
 }
 
@@ -2168,29 +2376,24 @@ static void add_routing_widgets(
   if (ss_alt)
     alsa_elem_add_callback(ss_alt, monitor_group_changed, NULL, NULL);
 
-  // Register callbacks on Main/Alt Group controls (switches and sources)
-  for (int i = 1; i <= 8; i++) {
-    char name[64];
-
-    snprintf(name, sizeof(name), "Main Group Output %d Playback Switch", i);
-    struct alsa_elem *main_sw = get_elem_by_name(card->elems, name);
-    if (main_sw)
-      alsa_elem_add_callback(main_sw, monitor_group_changed, NULL, NULL);
-
-    snprintf(name, sizeof(name), "Alt Group Output %d Playback Switch", i);
-    struct alsa_elem *alt_sw = get_elem_by_name(card->elems, name);
-    if (alt_sw)
-      alsa_elem_add_callback(alt_sw, monitor_group_changed, NULL, NULL);
-
-    snprintf(name, sizeof(name), "Main Group Output %d Source Playback Enum", i);
-    struct alsa_elem *main_src = get_elem_by_name(card->elems, name);
-    if (main_src)
-      alsa_elem_add_callback(main_src, monitor_group_changed, NULL, NULL);
-
-    snprintf(name, sizeof(name), "Alt Group Output %d Source Playback Enum", i);
-    struct alsa_elem *alt_src = get_elem_by_name(card->elems, name);
-    if (alt_src)
-      alsa_elem_add_callback(alt_src, monitor_group_changed, NULL, NULL);
+  // Register callbacks on the Main/Alt Group controls (switches and
+  // sources) cached in each sink, so a change only updates that sink
+  for (int i = 0; i < card->routing_snks->len; i++) {
+    struct routing_snk *r_snk = &g_array_index(
+      card->routing_snks, struct routing_snk, i
+    );
+    struct alsa_elem *group_elems[] = {
+      r_snk->main_group_switch,
+      r_snk->alt_group_switch,
+      r_snk->main_group_source,
+      r_snk->alt_group_source
+    };
+
+    for (int j = 0; j < G_N_ELEMENTS(group_elems); j++)
+      if (group_elems[j])
+        alsa_elem_add_callback(
+          group_elems[j], monitor_group_snk_changed, r_snk, NULL
+        );
   }
 
   // Initialize effective source indices for all sinks
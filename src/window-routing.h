@@ -16,7 +16,12 @@ void update_hw_output_label(struct routing_snk *r_snk);
 void update_routing_src_label(struct routing_src *r_src);
 
 // Update cached effective source index for a routing sink
-void update_snk_effective_source(struct routing_snk *r_snk);
+// Returns true if the effective source changed
+int update_snk_effective_source(struct routing_snk *r_snk);
+
+// Update the mixer labels and routing lines after a routing preset
+// has been applied (called from the pending UI update idle)
+void flush_routing_ui_update(struct alsa_card *card);
 
 // Update all PCM labels when channel availability changes
 void update_all_pcm_labels(struct alsa_card *card);
@@ -31,5 +36,9 @@ int is_snk_monitor_muted(struct routing_snk *r_snk);
 void arrange_src_grid(struct alsa_card *card, int port_category);
 void arrange_snk_grid(struct alsa_card *card, int port_category);
 
+// Mark the cached hit-test rectangles stale after the routing
+// sources or sinks may have moved or changed size
+void routing_hit_index_invalidate(struct alsa_card *card);
+
 // Release refs held on routing widgets (call before window destroy)
 void cleanup_routing_widgets(struct alsa_card *card);
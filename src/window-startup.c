@@ -9,6 +9,7 @@
 #include "scarlett2-ioctls.h"
 #include "widget-boolean.h"
 #include "widget-drop-down.h"
+#include "window-helper.h"
 #include "window-startup.h"
 
 // Wrapper for create_update_firmware_window (passes NULL for parent_label)
@@ -446,3 +447,14 @@ GtkWidget *create_startup_controls(struct alsa_card *card) {
 
   return top;
 }
+
+GtkWidget *create_startup_window(struct alsa_card *card) {
+  GtkWidget *w = create_subwindow(
+    card, "Startup Configuration", G_CALLBACK(window_startup_close_request)
+  );
+
+  GtkWidget *startup = create_startup_controls(card);
+  gtk_window_set_child(GTK_WINDOW(w), startup);
+
+  return w;
+}
@@ -6,3 +6,6 @@
 #include "alsa.h"
 
 GtkWidget *create_startup_controls(struct alsa_card *card);
+
+// Create the Startup Configuration window (not shown)
+GtkWidget *create_startup_window(struct alsa_card *card);